@@ -0,0 +1,835 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "../src/cvss.h"
+#include "../src/cvss_2.h"
+#include "../src/cvss_2_engine.h"
+#include "../src/cvss_3.h"
+#include "../src/cvss_3_1.h"
+#include "../src/cvss_3_engine.h"
+#include "../src/cvss_3_incremental.h"
+#include "../src/cvss_3_integer.h"
+#include "../src/cvss_4_0.h"
+#include "../src/cvss_4_engine.h"
+#include "../src/cvss_batch.h"
+#include "../src/cvss_binary.h"
+#include "../src/cvss_cache.h"
+#include "../src/cvss_canonical.h"
+#include "../src/cvss_columns.h"
+#include "../src/cvss_csv.h"
+#include "../src/cvss_nvd.h"
+#include "../src/cvss_packed.h"
+#include "../src/cvss_profile.h"
+#include "../src/cvss_score.h"
+#include "../src/cvss_summary.h"
+#include "../src/cvss_table.h"
+#include "../src/cvss_vector.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//random mix of 3.0/3.1 vectors, about half with temporal and half with environmental metrics
+static string MakeVector(mt19937 &rng)
+{
+	static const char *const base[][2] = { { "AV", "NALP" }, { "AC", "LH" }, { "PR", "NLH" }, { "UI", "NR" }, { "S", "UC" }, { "C", "HLN" }, { "I", "HLN" }, { "A", "HLN" } };
+	static const char *const temporal[][2] = { { "E", "XUPFH" }, { "RL", "XOTWU" }, { "RC", "XURC" } };
+	static const char *const environmental[][2] = { { "CR", "XHML" }, { "IR", "XHML" }, { "AR", "XHML" }, { "MAV", "XNALP" }, { "MAC", "XLH" }, { "MPR", "XNLH" }, { "MUI", "XNR" }, { "MS", "XUC" }, { "MC", "XHLN" }, { "MI", "XHLN" }, { "MA", "XHLN" } };
+	auto append = [&](string &vector, const char *const metric[2]) {
+		string_view values(metric[1]);
+		vector += '/';
+		vector += metric[0];
+		vector += ':';
+		vector += values[rng() % values.length()];
+	};
+
+	string ret = (rng() % 2) ? "CVSS:3.1" : "CVSS:3.0";
+	for (auto metric : base)
+		append(ret, metric);
+	if (rng() % 2)
+		for (auto metric : temporal)
+			append(ret, metric);
+	if (rng() % 2)
+		for (auto metric : environmental)
+			if (rng() % 5 < 3)
+				append(ret, metric);
+	return ret;
+}
+
+//random 4.0 vectors, about half with the threat metric and half with environmental metrics
+static string MakeVector4(mt19937 &rng)
+{
+	static const char *const base[][2] = { { "AV", "NALP" }, { "AC", "LH" }, { "AT", "NP" }, { "PR", "NLH" }, { "UI", "NPA" }, { "VC", "HLN" }, { "VI", "HLN" }, { "VA", "HLN" }, { "SC", "HLN" }, { "SI", "HLN" }, { "SA", "HLN" } };
+	static const char *const environmental[][2] = { { "CR", "XHML" }, { "IR", "XHML" }, { "AR", "XHML" }, { "MAV", "XNALP" }, { "MAC", "XLH" }, { "MAT", "XNP" }, { "MPR", "XNLH" }, { "MUI", "XNPA" }, { "MVC", "XHLN" }, { "MVI", "XHLN" }, { "MVA", "XHLN" }, { "MSC", "XHLN" }, { "MSI", "XHLNS" }, { "MSA", "XHLNS" } };
+	auto append = [&](string &vector, const char *const metric[2]) {
+		string_view values(metric[1]);
+		vector += '/';
+		vector += metric[0];
+		vector += ':';
+		vector += values[rng() % values.length()];
+	};
+
+	string ret = "CVSS:4.0";
+	for (auto metric : base)
+		append(ret, metric);
+	if (rng() % 2)
+		ret += "/E:" + string(1, "XAPU"[rng() % 4]);
+	if (rng() % 2)
+		for (auto metric : environmental)
+			if (rng() % 5 < 3)
+				append(ret, metric);
+	return ret;
+}
+
+//random 2.0 vectors, about half with temporal and half with environmental metrics
+static string MakeVector2(mt19937 &rng)
+{
+	static const char *const base[][2] = { { "AV", "L,A,N" }, { "AC", "H,M,L" }, { "Au", "M,S,N" }, { "C", "N,P,C" }, { "I", "N,P,C" }, { "A", "N,P,C" } };
+	static const char *const temporal[][2] = { { "E", "ND,U,POC,F,H" }, { "RL", "ND,OF,TF,W,U" }, { "RC", "ND,UC,UR,C" } };
+	static const char *const environmental[][2] = { { "CDP", "ND,N,L,LM,MH,H" }, { "TD", "ND,N,L,M,H" }, { "CR", "ND,H,M,L" }, { "IR", "ND,H,M,L" }, { "AR", "ND,H,M,L" } };
+	auto append = [&](string &text, const char *const metric[2]) {
+		vector<string_view> values;
+		string_view list(metric[1]);
+		for (size_t start = 0, end = 0; end != string_view::npos; start = end + 1)
+		{
+			end = list.find(',', start);
+			values.push_back(list.substr(start, (end == string_view::npos) ? string_view::npos : end - start));
+		}
+		if (!text.empty())
+			text += '/';
+		text += metric[0];
+		text += ':';
+		text += values[rng() % values.size()];
+	};
+
+	string ret;
+	for (auto metric : base)
+		append(ret, metric);
+	if (rng() % 2)
+		for (auto metric : temporal)
+			append(ret, metric);
+	if (rng() % 2)
+		for (auto metric : environmental)
+			append(ret, metric);
+	return ret;
+}
+
+//feeds repeat a few thousand distinct vectors with a long-tailed (Zipf-like) distribution
+static vector<string> MakeCorpus(size_t count, string (*makeVector)(mt19937 &rng), const char *common)
+{
+	mt19937 rng(42);
+	vector<string> distinct;
+	for (size_t n = 0; n < 4096; n++)
+		distinct.push_back(makeVector(rng));
+	distinct[0] = common;
+
+	vector<double> weights;
+	for (size_t n = 0; n < distinct.size(); n++)
+		weights.push_back(1.0 / (n + 1));
+	discrete_distribution<size_t> pick(weights.begin(), weights.end());
+
+	vector<string> ret;
+	ret.reserve(count);
+	for (size_t n = 0; n < count; n++)
+		ret.push_back((n % 5 == 0) ? makeVector(rng) : distinct[pick(rng)]);
+	return ret;
+}
+
+static const vector<string> &GetCorpus()
+{
+	static const vector<string> corpus = MakeCorpus(1 << 18, MakeVector, "CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H");
+	return corpus;
+}
+
+static const vector<string> &GetCorpus4()
+{
+	static const vector<string> corpus = MakeCorpus(1 << 18, MakeVector4, "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N");
+	return corpus;
+}
+
+static const vector<string> &GetCorpus2()
+{
+	static const vector<string> corpus = MakeCorpus(1 << 18, MakeVector2, "AV:N/AC:L/Au:N/C:C/I:C/A:C");
+	return corpus;
+}
+
+static const vector<ParsedVector> &GetParsedCorpus()
+{
+	static const vector<ParsedVector> parsed = [] {
+		vector<ParsedVector> ret;
+		for (auto const& vector : GetCorpus())
+			ret.push_back(ParseVector(vector));
+		return ret;
+	}();
+	return parsed;
+}
+
+template<typename T> static vector<T> MakeObjects()
+{
+	vector<T> ret;
+	for (auto const& v : GetParsedCorpus())
+		ret.emplace_back(v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a, v.e, v.rl, v.rc, v.cr, v.ir, v.ar, v.mav, v.mac, v.mpr, v.mui, v.ms, v.mc, v.mi, v.ma);
+	return ret;
+}
+
+//per-vector cost of the original entry point; its output goes nowhere
+static void BM_Parse(benchmark::State &state)
+{
+	struct NullBuffer : streambuf
+	{
+		int overflow(int c) override { return c; }
+	} nullBuffer;
+	auto const& corpus = GetCorpus();
+	streambuf *old = cout.rdbuf(&nullBuffer);
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Parse(corpus[n], true, true, true, true));
+		n = (n + 1) % corpus.size();
+	}
+	cout.rdbuf(old);
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Parse);
+
+static void BM_ParseVector(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ParseVector(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseVector);
+
+static void BM_ParseVector4(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus4();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ParseVector4(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseVector4);
+
+static void BM_ParseVector2(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus2();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ParseVector2(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseVector2);
+
+static void BM_Score(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Score(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Score);
+
+//BM_Score for 4.0 vectors
+static void BM_Score4(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus4();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Score(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Score4);
+
+//BM_Score for 2.0 vectors
+static void BM_Score2(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus2();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Score(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Score2);
+
+//BM_Score, adding each vector to a ScoreSummary instead of returning its scores
+static void BM_Summarize(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	ScoreSummary summary;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(Summarize(corpus[n], summary));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Summarize);
+
+//deduplicating a feed: parse and key each vector, numbering the distinct ones, against scoring each one
+static void BM_DistinctVectors(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	DistinctVectors distinct;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(distinct.Add(GetCanonicalKey(ParseVector(corpus[n]))));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.counters["distinct"] = static_cast<double>(distinct.GetCount());
+}
+BENCHMARK(BM_DistinctVectors);
+
+static void BM_ScoreCache(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	ScoreCache cache(static_cast<size_t>(state.range(0)));
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(cache.Score(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.counters["hit_rate"] = static_cast<double>(cache.GetHits()) / max<uint64_t>(cache.GetHits() + cache.GetMisses(), 1);
+}
+BENCHMARK(BM_ScoreCache)->Arg(1024)->Arg(DefaultScoreCacheSize);
+
+//one environmental profile over many vectors: appending it to each vector and reparsing, against EnvironmentalProfile
+static const char *BenchProfile = "CR:H/IR:H/MAV:L";
+
+static void BM_ProfileAppend(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	string buffer;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		buffer.assign(corpus[n]);
+		buffer.push_back('/');
+		buffer.append(BenchProfile);
+		benchmark::DoNotOptimize(Score(buffer));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProfileAppend);
+
+static void BM_EnvironmentalProfile(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	EnvironmentalProfile profile;
+	profile.Parse(BenchProfile);
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(profile.Score(corpus[n]));
+		n = (n + 1) % corpus.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EnvironmentalProfile);
+
+static void BM_CVSS_3_1_Construct(benchmark::State &state)
+{
+	auto const& parsed = GetParsedCorpus();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		ParsedVector const& v = parsed[n];
+		CVSS_3_1 *cvss = new CVSS_3_1(v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a, v.e, v.rl, v.rc, v.cr, v.ir, v.ar, v.mav, v.mac, v.mpr, v.mui, v.ms, v.mc, v.mi, v.ma);
+		benchmark::DoNotOptimize(cvss);
+		delete cvss;
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_1_Construct);
+
+template<typename T, float (T::*Getter)(bool)> static void BM_Getter(benchmark::State &state)
+{
+	vector<T> objects = MakeObjects<T>();
+	bool modified = state.range(0) != 0;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize((objects[n].*Getter)(modified));
+		n = (n + 1) % objects.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3_1, &CVSS_3_1::GetTemporalScore)->Name("BM_CVSS_3_1_GetTemporalScore")->Arg(1);
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3_1, &CVSS_3_1::GetEnvironmentalScore)->Name("BM_CVSS_3_1_GetEnvironmentalScore")->Arg(1);
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3_1, &CVSS_3_1::GetImpactSubScore)->Name("BM_CVSS_3_1_GetImpactSubScore")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3_1, &CVSS_3_1::GetExploitability)->Name("BM_CVSS_3_1_GetExploitability")->Arg(0)->Arg(1);
+//3.0 and 3.1 differ only in the modified impact formula
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3_1, &CVSS_3_1::GetImpact)->Name("BM_CVSS_3_1_GetImpact")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Getter, CVSS_3, &CVSS_3::GetImpact)->Name("BM_CVSS_3_GetImpact")->Arg(0)->Arg(1);
+
+static void BM_CVSS_3_1_GetBaseScore(benchmark::State &state)
+{
+	vector<CVSS_3_1> objects = MakeObjects<CVSS_3_1>();
+	bool modified = state.range(0) != 0;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(objects[n].GetBaseScore(modified));
+		n = (n + 1) % objects.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_1_GetBaseScore)->Arg(0)->Arg(1);
+
+//all three scores per vector: what Parse() used to do through a heap CVSS*, and the stack engine it uses now
+static void BM_CVSS_3_1_HeapScores(benchmark::State &state)
+{
+	auto const& parsed = GetParsedCorpus();
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		ParsedVector const& v = parsed[n];
+		CVSS *cvss = new CVSS_3_1(v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a, v.e, v.rl, v.rc, v.cr, v.ir, v.ar, v.mav, v.mac, v.mpr, v.mui, v.ms, v.mc, v.mi, v.ma);
+		benchmark::DoNotOptimize(cvss->GetBaseScore());
+		benchmark::DoNotOptimize(cvss->GetTemporalScore());
+		benchmark::DoNotOptimize(cvss->GetEnvironmentalScore());
+		delete cvss;
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_1_HeapScores);
+
+static void BM_CVSS_3_EngineScores(benchmark::State &state)
+{
+	auto const& parsed = GetParsedCorpus();
+	CVSS_3_Engine<CVSSVersion::V3_1> engine;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(parsed[n]);
+		benchmark::DoNotOptimize(engine.GetBaseScore());
+		benchmark::DoNotOptimize(engine.GetTemporalScore());
+		benchmark::DoNotOptimize(engine.GetEnvironmentalScore());
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_EngineScores);
+
+static void BM_CVSS_3_IntegerEngineScores(benchmark::State &state)
+{
+	auto const& parsed = GetParsedCorpus();
+	CVSS_3_IntegerEngine<CVSSVersion::V3_1> engine;
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(parsed[n]);
+		benchmark::DoNotOptimize(engine.GetBaseScore());
+		benchmark::DoNotOptimize(engine.GetTemporalScore());
+		benchmark::DoNotOptimize(engine.GetEnvironmentalScore());
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_IntegerEngineScores);
+
+//BM_CVSS_3_EngineScores for 4.0 vectors
+static void BM_CVSS_4_EngineScores(benchmark::State &state)
+{
+	static const vector<ParsedVector4> parsed = [] {
+		vector<ParsedVector4> ret;
+		for (auto const& vector : GetCorpus4())
+			ret.push_back(ParseVector4(vector));
+		return ret;
+	}();
+	CVSS_4_Engine engine(parsed[0]);
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(parsed[n]);
+		benchmark::DoNotOptimize(engine.GetBaseScore());
+		benchmark::DoNotOptimize(engine.GetTemporalScore());
+		benchmark::DoNotOptimize(engine.GetEnvironmentalScore());
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_4_EngineScores);
+
+//BM_CVSS_3_EngineScores for 2.0 vectors
+static void BM_CVSS_2_EngineScores(benchmark::State &state)
+{
+	static const vector<ParsedVector2> parsed = [] {
+		vector<ParsedVector2> ret;
+		for (auto const& vector : GetCorpus2())
+			ret.push_back(ParseVector2(vector));
+		return ret;
+	}();
+	CVSS_2_Engine engine(parsed[0]);
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		engine.Reset(parsed[n]);
+		benchmark::DoNotOptimize(engine.GetBaseScore());
+		benchmark::DoNotOptimize(engine.GetTemporalScore());
+		benchmark::DoNotOptimize(engine.GetEnvironmentalScore());
+		n = (n + 1) % parsed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_2_EngineScores);
+
+//what-if analysis: toggle the modified attack vector and read the environmental score
+static void BM_CVSS_3_1_WhatIf(benchmark::State &state)
+{
+	vector<CVSS_3_1> objects = MakeObjects<CVSS_3_1>();
+	size_t n = 0;
+	unsigned toggle = 0;
+	for (auto _ : state)
+	{
+		objects[n].SetAttackVector(static_cast<AttackVector>(toggle++ % 4), true);
+		benchmark::DoNotOptimize(objects[n].GetEnvironmentalScore());
+		n = (n + 1) % objects.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_1_WhatIf);
+
+static void BM_CVSS_3_IncrementalWhatIf(benchmark::State &state)
+{
+	vector<CVSS_3_Incremental<CVSSVersion::V3_1>> objects;
+	for (auto const& v : GetParsedCorpus())
+		objects.emplace_back(v);
+	size_t n = 0;
+	unsigned toggle = 0;
+	for (auto _ : state)
+	{
+		objects[n].SetAttackVector(static_cast<AttackVector>(toggle++ % 4), true);
+		benchmark::DoNotOptimize(objects[n].GetEnvironmentalScore());
+		n = (n + 1) % objects.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CVSS_3_IncrementalWhatIf);
+
+static void BM_LookupScores(benchmark::State &state)
+{
+	vector<PackedVector> packed;
+	for (auto const& v : GetParsedCorpus())
+		packed.emplace_back(v);
+	size_t n = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(packed[n].GetBaseScore());
+		benchmark::DoNotOptimize(packed[n].GetTemporalScore());
+		benchmark::DoNotOptimize(packed[n].GetEnvironmentalScore());
+		n = (n + 1) % packed.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LookupScores);
+
+static void BM_ScoreColumns(benchmark::State &state)
+{
+	ScoreKernel kernel = static_cast<ScoreKernel>(state.range(0));
+	if (!IsScoreKernelSupported(kernel))
+	{
+		state.SkipWithError("kernel not supported on this CPU");
+		return;
+	}
+	auto const& parsed = GetParsedCorpus();
+	vector<vector<uint8_t>> columns(22, vector<uint8_t>(parsed.size()));
+	for (size_t n = 0; n < parsed.size(); n++)
+	{
+		ParsedVector const& v = parsed[n];
+		const uint8_t values[22] = { uint8_t(v.av), uint8_t(v.ac), uint8_t(v.pr), uint8_t(v.ui), uint8_t(v.s), uint8_t(v.c), uint8_t(v.i), uint8_t(v.a), uint8_t(v.e), uint8_t(v.rl), uint8_t(v.rc), uint8_t(v.cr), uint8_t(v.ir), uint8_t(v.ar),
+			v.mav.modified ? uint8_t(v.mav.parent) : MetricNotDefined, v.mac.modified ? uint8_t(v.mac.parent) : MetricNotDefined, v.mpr.modified ? uint8_t(v.mpr.parent) : MetricNotDefined, v.mui.modified ? uint8_t(v.mui.parent) : MetricNotDefined,
+			v.ms.modified ? uint8_t(v.ms.parent) : MetricNotDefined, v.mc.modified ? uint8_t(v.mc.parent) : MetricNotDefined, v.mi.modified ? uint8_t(v.mi.parent) : MetricNotDefined, v.ma.modified ? uint8_t(v.ma.parent) : MetricNotDefined };
+		for (size_t k = 0; k < 22; k++)
+			columns[k][n] = values[k];
+	}
+	MetricColumns m;
+	m.count = parsed.size();
+	const uint8_t **fields[22] = { &m.av, &m.ac, &m.pr, &m.ui, &m.s, &m.c, &m.i, &m.a, &m.e, &m.rl, &m.rc, &m.cr, &m.ir, &m.ar, &m.mav, &m.mac, &m.mpr, &m.mui, &m.ms, &m.mc, &m.mi, &m.ma };
+	for (size_t k = 0; k < 22; k++)
+		*fields[k] = columns[k].data();
+
+	vector<float> base(m.count), temporal(m.count), environmental(m.count);
+	for (auto _ : state)
+	{
+		ScoreColumns(m, base.data(), temporal.data(), environmental.data(), kernel);
+		benchmark::ClobberMemory();
+	}
+	state.SetLabel(ScoreKernelString(kernel));
+	state.SetItemsProcessed(state.iterations() * m.count);
+}
+BENCHMARK(BM_ScoreColumns)->DenseRange(static_cast<int>(ScoreKernel::Scalar), static_cast<int>(ScoreKernel::NEON));
+
+static void BM_ScoreBatchThreads(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	vector<string_view> vectors(corpus.begin(), corpus.end());
+	vector<ScoreResult> results(vectors.size());
+	ThreadPool pool(static_cast<unsigned>(state.range(0)));
+	for (auto _ : state)
+	{
+		ScoreBatch(vectors.data(), vectors.size(), results.data(), pool);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+BENCHMARK(BM_ScoreBatchThreads)->DenseRange(1, max(thread::hardware_concurrency(), 1u))->UseRealTime();
+
+//per-worker summaries merged at the end, against ScoreBatch() filling a result per vector
+static void BM_SummarizeBatchThreads(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	vector<string_view> vectors(corpus.begin(), corpus.end());
+	ThreadPool pool(static_cast<unsigned>(state.range(0)));
+	for (auto _ : state)
+	{
+		ScoreSummary summary;
+		SummarizeBatch(vectors.data(), vectors.size(), summary, pool);
+		benchmark::DoNotOptimize(summary.GetCount());
+	}
+	state.SetItemsProcessed(state.iterations() * vectors.size());
+}
+BENCHMARK(BM_SummarizeBatchThreads)->DenseRange(1, max(thread::hardware_concurrency(), 1u))->UseRealTime();
+
+//whole CLI batch path: line splitting, parsing, scoring and formatting, from a stream or from memory (as with a mapped file)
+static void BM_ParseBatchThreads(benchmark::State &state)
+{
+	auto const& corpus = GetCorpus();
+	bool fromMemory = state.range(1) != 0;
+	string input;
+	for (auto const& vector : corpus)
+	{
+		input += vector;
+		input += '\n';
+	}
+	for (auto _ : state)
+	{
+		ostringstream out;
+		ostringstream err;
+		if (fromMemory)
+		{
+			ParseBatch(string_view(input), out, err, true, true, true, false, static_cast<unsigned>(state.range(0)));
+		}
+		else
+		{
+			istringstream in(input);
+			ParseBatch(in, out, err, true, true, true, false, static_cast<unsigned>(state.range(0)));
+		}
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(state.iterations() * corpus.size());
+	state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_ParseBatchThreads)->ArgsProduct({ benchmark::CreateDenseRange(1, max(thread::hardware_concurrency(), 1u), 1), { 0, 1 } })->ArgNames({ "threads", "memory" })->UseRealTime();
+
+//an NVD 2.0-style feed of the corpus: each vector in a CVE record padded with the description, reference and
+//configuration text that makes up most of a real feed
+static string MakeNVDFeed()
+{
+	auto const& corpus = GetCorpus();
+	string feed = "{\"format\":\"NVD_CVE\",\"version\":\"2.0\",\"vulnerabilities\":[";
+	for (size_t n = 0; n < corpus.size(); n++)
+	{
+		if (n)
+			feed += ',';
+		feed += "{\"cve\":{\"id\":\"CVE-2023-" + to_string(10000 + n) + "\",\"sourceIdentifier\":\"cve@mitre.org\",\"descriptions\":[{\"lang\":\"en\",\"value\":\"";
+		for (size_t i = 0; i < 1 + n % 6; i++)
+			feed += "A \\\"crafted\\\" request to C:\\\\path allows a remote attacker to execute arbitrary code. ";
+		feed += "\"}],\"metrics\":{\"cvssMetricV31\":[{\"source\":\"nvd@nist.gov\",\"type\":\"Primary\",\"cvssData\":{\"version\":\"3.1\",\"vectorString\":\"" + corpus[n] + "\",\"baseScore\":9.8}}]},";
+		feed += "\"configurations\":[{\"nodes\":[{\"operator\":\"OR\",\"negate\":false,\"cpeMatch\":[{\"vulnerable\":true,\"criteria\":\"cpe:2.3:a:vendor:product:*:*:*:*:*:*:*:*\"}]}]}],";
+		feed += "\"references\":[{\"url\":\"https://example.com/advisory/" + to_string(n) + "\",\"source\":\"cve@mitre.org\"}]}}";
+	}
+	feed += "]}";
+	return feed;
+}
+
+//extraction alone: how fast the feed can be scanned for CVE IDs and vectors
+static void BM_NVDScan(benchmark::State &state)
+{
+	string feed = MakeNVDFeed();
+	size_t found = 0;
+	NVDScanner scanner([&found](string_view, string_view) { found++; });
+	for (auto _ : state)
+	{
+		scanner.Reset();
+		scanner.Feed(feed);
+	}
+	benchmark::DoNotOptimize(found);
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+	state.SetBytesProcessed(state.iterations() * feed.size());
+}
+BENCHMARK(BM_NVDScan);
+
+//whole --nvd path: extraction, scoring and formatting, from memory (as with a mapped file)
+static void BM_ParseNVD(benchmark::State &state)
+{
+	string feed = MakeNVDFeed();
+	for (auto _ : state)
+	{
+		ostringstream out;
+		ostringstream err;
+		ParseNVD(string_view(feed), out, err, true, true, true);
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+	state.SetBytesProcessed(state.iterations() * feed.size());
+}
+BENCHMARK(BM_ParseNVD);
+
+//--csv path: an export with the vector in the third of five columns, some fields quoted, copied through with
+//score columns appended, against extracting the rows alone
+static string MakeCSVExport()
+{
+	auto const& corpus = GetCorpus();
+	string csv = "asset,host,vector,owner,notes\n";
+	for (size_t n = 0; n < corpus.size(); n++)
+	{
+		csv += "A" + to_string(n) + ",host-" + to_string(n) + ".example.com,";
+		csv += (n % 3) ? corpus[n] : '"' + corpus[n] + '"';
+		csv += ",\"Operations, team " + to_string(n % 17) + "\",\"reviewed, \"\"accepted\"\"\"\n";
+	}
+	return csv;
+}
+
+static void BM_CSVRows(benchmark::State &state)
+{
+	string csv = MakeCSVExport();
+	for (auto _ : state)
+	{
+		CSVIterator rows(csv, ',', 2);
+		string_view row, ending, field;
+		bool hasField;
+		size_t length = 0;
+		while (rows.Next(row, ending, field, hasField))
+			length += field.size();
+		benchmark::DoNotOptimize(length);
+	}
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+	state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_CSVRows);
+
+static void BM_ParseCSV(benchmark::State &state)
+{
+	string csv = MakeCSVExport();
+	for (auto _ : state)
+	{
+		ostringstream out;
+		ostringstream err;
+		ParseCSV(string_view(csv), out, err, 2, ',', true, true, true, true);
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+	state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_ParseCSV);
+
+//downstream cost of reading batch results back: text lines through a float parser, against binary columns
+static string MakeBatchOutput(bool binary)
+{
+	auto const& corpus = GetCorpus();
+	string input;
+	for (auto const& vector : corpus)
+	{
+		input += vector;
+		input += '\n';
+	}
+	ostringstream out;
+	ostringstream err;
+	ParseBatch(string_view(input), out, err, true, true, true, true, 1, 0, nullptr, binary);
+	return out.str();
+}
+
+static void BM_ReadTextScores(benchmark::State &state)
+{
+	string output = MakeBatchOutput(false);
+	for (auto _ : state)
+	{
+		float sum = 0;
+		const char *p = output.c_str();
+		char *end;
+		while (*p)
+		{
+			sum += strtof(p, &end); //base, temporal and environmental
+			p = (end == p) ? p + 1 : end;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+}
+BENCHMARK(BM_ReadTextScores);
+
+static void BM_ReadBinaryScores(benchmark::State &state)
+{
+	string output = MakeBatchOutput(true);
+	for (auto _ : state)
+	{
+		ScoreFile file;
+		file.Load(output);
+		unsigned sum = 0;
+		for (size_t block = 0; block < file.GetBlockCount(); block++)
+		{
+			BinaryBlock columns = file.GetBlock(block);
+			for (size_t n = 0; n < columns.count; n++)
+				sum += columns.base[n] + columns.temporal[n] + columns.environmental[n];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * GetCorpus().size());
+}
+BENCHMARK(BM_ReadBinaryScores);
+
+BENCHMARK_MAIN();
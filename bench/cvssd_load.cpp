@@ -0,0 +1,289 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_server.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+//load generator for cvssd: each connection keeps a fixed number of requests in flight and times every one
+//from queuing it to reading its answer
+
+struct Load
+{
+	string socketPath = "/tmp/cvssd.sock";
+	unsigned connections = 1;
+	size_t depth = 64;
+	size_t requests = 1000000; //per connection
+	bool frames = false;
+	vector<string> vectors;
+};
+
+struct ConnectionResult
+{
+	LatencyHistogram latency;
+	size_t answered = 0;
+	size_t errors = 0;
+	bool failed = false;
+};
+
+static int Connect(string const& socketPath)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+		return -1;
+	memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if ((fd >= 0) && (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0))
+	{
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static void AppendRequest(string &output, string_view vector, bool frame)
+{
+	if (frame)
+	{
+		for (size_t n = 0; n < FrameHeaderSize; n++)
+			output.push_back(static_cast<char>((vector.size() >> (8 * (FrameHeaderSize - 1 - n))) & 0xFF));
+		output.append(vector);
+	}
+	else
+	{
+		output.append(vector);
+		output.push_back('\n');
+	}
+}
+
+//the length of the first answer in data, with its line break or frame header, or 0 if it is incomplete
+static size_t GetAnswerLength(string_view data, bool frame, string_view &answer)
+{
+	if (frame)
+	{
+		if (data.size() < FrameHeaderSize)
+			return 0;
+		size_t length = 0;
+		for (size_t n = 0; n < FrameHeaderSize; n++)
+			length = (length << 8) | static_cast<unsigned char>(data[n]);
+		if (data.size() - FrameHeaderSize < length)
+			return 0;
+		answer = data.substr(FrameHeaderSize, length);
+		return FrameHeaderSize + length;
+	}
+	size_t end = data.find('\n');
+	if (end == string_view::npos)
+		return 0;
+	answer = data.substr(0, end);
+	return end + 1;
+}
+
+static void RunConnection(Load const& load, size_t first, ConnectionResult &result)
+{
+	int fd = Connect(load.socketPath);
+	if (fd < 0)
+	{
+		result.failed = true;
+		return;
+	}
+
+	vector<uint64_t> queuedAt(load.depth); //a ring, since answers come back in order
+	string output;
+	size_t written = 0;
+	vector<char> input(64 * 1024);
+	size_t inputSize = 0;
+	size_t sent = 0;
+	while (result.answered < load.requests)
+	{
+		while ((sent < load.requests) && (sent - result.answered < load.depth))
+		{
+			AppendRequest(output, load.vectors[(first + sent) % load.vectors.size()], load.frames);
+			queuedAt[sent % load.depth] = GetSteadyNanoseconds();
+			sent++;
+		}
+
+		pollfd ready = { fd, static_cast<short>(POLLIN | ((written < output.size()) ? POLLOUT : 0)), 0 };
+		if (poll(&ready, 1, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (ready.revents & POLLOUT)
+		{
+			ssize_t n = send(fd, output.data() + written, output.size() - written, MSG_DONTWAIT | MSG_NOSIGNAL);
+			if (n > 0)
+				written += static_cast<size_t>(n);
+			if (written == output.size())
+			{
+				output.clear();
+				written = 0;
+			}
+		}
+		if (ready.revents & (POLLIN | POLLHUP | POLLERR))
+		{
+			ssize_t n = recv(fd, input.data() + inputSize, input.size() - inputSize, MSG_DONTWAIT);
+			if (n <= 0)
+			{
+				if ((n < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+					continue;
+				break;
+			}
+			inputSize += static_cast<size_t>(n);
+			uint64_t now = GetSteadyNanoseconds();
+			size_t position = 0;
+			string_view answer;
+			while (size_t length = GetAnswerLength(string_view(input.data() + position, inputSize - position), load.frames, answer))
+			{
+				result.latency.Add(now - queuedAt[result.answered % load.depth]);
+				if (answer.rfind("error", 0) == 0)
+					result.errors++;
+				result.answered++;
+				position += length;
+			}
+			memmove(input.data(), input.data() + position, inputSize - position);
+			inputSize -= position;
+		}
+	}
+	result.failed = (result.answered < load.requests);
+	close(fd);
+}
+
+int main(int argc, char *argv[])
+{
+	Load load;
+	string vectorFile;
+	for (int i2 = 1; i2 < argc; i2++)
+	{
+		string arg(argv[i2]);
+		if ((arg.compare("-h") == 0) || (arg.compare("--help") == 0))
+		{
+			cout << "Usage: ./cvssd_load [--socket path] [--connections N] [--depth N] [--requests N] [--frames] [--file vectors]" << endl;
+			cout << endl;
+			cout << " --socket path  cvssd socket (default /tmp/cvssd.sock)." << endl;
+			cout << " --connections N  Open N connections, each on its own thread (default 1)." << endl;
+			cout << " --depth N  Keep N requests in flight per connection (default 64)." << endl;
+			cout << " --requests N  Send N requests per connection (default 1000000)." << endl;
+			cout << " --frames  Send length-prefixed frames instead of lines." << endl;
+			cout << " --file vectors  Send the vectors in this file, one per line, in turn." << endl;
+			return EXIT_SUCCESS;
+		}
+		else if ((arg.compare("--socket") == 0) && (i2 + 1 < argc))
+			load.socketPath = argv[++i2];
+		else if ((arg.compare("--connections") == 0) && (i2 + 1 < argc))
+			load.connections = max(static_cast<unsigned>(strtoul(argv[++i2], nullptr, 10)), 1u);
+		else if ((arg.compare("--depth") == 0) && (i2 + 1 < argc))
+			load.depth = max(static_cast<size_t>(strtoull(argv[++i2], nullptr, 10)), size_t(1));
+		else if ((arg.compare("--requests") == 0) && (i2 + 1 < argc))
+			load.requests = static_cast<size_t>(strtoull(argv[++i2], nullptr, 10));
+		else if (arg.compare("--frames") == 0)
+			load.frames = true;
+		else if ((arg.compare("--file") == 0) && (i2 + 1 < argc))
+			vectorFile = argv[++i2];
+		else
+		{
+			cerr << "Unknown option " << arg << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!vectorFile.empty())
+	{
+		ifstream in(vectorFile);
+		string line;
+		while (getline(in, line))
+		{
+			if (!line.empty() && (line.back() == '\r'))
+				line.pop_back();
+			if (!line.empty() && (line.size() <= MaxRequestSize))
+				load.vectors.push_back(line);
+		}
+	}
+	if (load.vectors.empty())
+	{
+		load.vectors = {
+			"CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H",
+			"CVSS:3.1/AV:N/AC:L/PR:N/UI:R/S:C/C:L/I:L/A:N",
+			"CVSS:3.1/AV:L/AC:L/PR:L/UI:N/S:U/C:H/I:N/A:N/E:P/RL:O/RC:C",
+			"CVSS:3.0/AV:A/AC:H/PR:H/UI:R/S:C/C:H/I:H/A:L/CR:H/IR:L/MAV:N/MS:U",
+			"CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N",
+			"AV:N/AC:L/Au:N/C:P/I:P/A:P/E:F/RL:OF/RC:C"
+		};
+	}
+
+	vector<ConnectionResult> results(load.connections);
+	vector<thread> threads;
+	uint64_t start = GetSteadyNanoseconds();
+	for (unsigned n = 0; n < load.connections; n++)
+		threads.emplace_back(RunConnection, cref(load), n * 7919, ref(results[n]));
+	for (auto &t : threads)
+		t.join();
+	double seconds = (GetSteadyNanoseconds() - start) / 1e9;
+
+	ConnectionResult total;
+	for (auto const& result : results)
+	{
+		total.latency.Merge(result.latency);
+		total.answered += result.answered;
+		total.errors += result.errors;
+		total.failed = total.failed || result.failed;
+	}
+	cout << "requests " << total.answered << "\terrors " << total.errors << "\tseconds " << seconds << "\trequests_per_second " << static_cast<uint64_t>(total.answered / max(seconds, 1e-9)) << "\tp50_ns " << total.latency.GetPercentile(50) << "\tp99_ns " << total.latency.GetPercentile(99) << endl;
+
+	//and the daemon's own view, which leaves out the socket round trip
+	int fd = Connect(load.socketPath);
+	if (fd >= 0)
+	{
+		string request;
+		AppendRequest(request, "STATS", load.frames);
+		string input;
+		char buffer[4096];
+		string_view answer;
+		if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size()))
+		{
+			ssize_t n;
+			while ((GetAnswerLength(input, load.frames, answer) == 0) && ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0))
+				input.append(buffer, static_cast<size_t>(n));
+			if (GetAnswerLength(input, load.frames, answer))
+				cout << "server " << answer << endl;
+		}
+		close(fd);
+	}
+
+	if (total.failed)
+	{
+		cerr << "Unable to complete the load on " << load.socketPath << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -17,8 +17,8 @@ along with this program; if not, write to the Free Software Foundation,
 Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
+#include "../src/cvss.h"
 #include <string>
-extern int Parse(std::string const& data, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors);
 
 extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
 {
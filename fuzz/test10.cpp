@@ -0,0 +1,56 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_score.h"
+#include "../src/cvss_stats.h"
+#include <cstdlib>
+#include <string_view>
+
+//every line scored is counted once, as its version or its parse error, and timed once as a parse;
+//builds without CVSS_INSTRUMENTATION must report nothing at all
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	ResetStats();
+	uint64_t lines = 0;
+	uint64_t failed[ParseErrorCount] = {};
+	for (size_t start = 0, end = 0; start <= input.size(); start = end + 1)
+	{
+		end = input.find('\n', start);
+		if (end == std::string_view::npos)
+			end = input.size();
+		ScoreResult result = Score(input.substr(start, end - start));
+		failed[static_cast<size_t>(result.error)]++;
+		lines++;
+	}
+
+	StatsSnapshot stats = GetStats();
+	if (!StatsEnabled())
+		lines = failed[0] = 0;
+	uint64_t versions = 0;
+	for (size_t version = 0; version < CVSSVersionCount; version++)
+		versions += stats.versions[version];
+	if ((stats.stages[static_cast<size_t>(Stage::Parse)].count != lines) || (versions != failed[0]))
+		abort();
+	for (size_t error = 1; error < ParseErrorCount; error++)
+	{
+		if (stats.errors[error] != (StatsEnabled() ? failed[error] : 0))
+			abort();
+	}
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_4_0.h"
+#include "../src/cvss_score.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+//published 4.0 scores
+static const struct
+{
+	const char *vector;
+	float score;
+} Known[] = {
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:H/VI:H/VA:H/SC:H/SI:H/SA:H", 10.0f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N", 9.3f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:L/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N", 8.7f },
+	{ "CVSS:4.0/AV:L/AC:L/AT:N/PR:L/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N", 8.5f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:N/VI:N/VA:H/SC:N/SI:N/SA:N", 8.7f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:L/UI:N/VC:N/VI:N/VA:H/SC:N/SI:N/SA:N", 7.1f },
+	{ "CVSS:4.0/AV:L/AC:L/AT:N/PR:L/UI:N/VC:N/VI:N/VA:H/SC:N/SI:N/SA:N", 6.8f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:L/VI:N/VA:N/SC:N/SI:N/SA:N", 6.9f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:L/UI:N/VC:L/VI:N/VA:N/SC:N/SI:N/SA:N", 5.3f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:A/VC:N/VI:N/VA:N/SC:L/SI:L/SA:N", 5.1f },
+	{ "CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:N/VI:N/VA:N/SC:N/SI:N/SA:N", 0.0f }
+};
+
+//any 4.0 vector that parses scores within 0 - 10 in whole tenths, identically through Score() and CVSS_4_0,
+//and its base score ignores the threat and environmental metrics
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	for (auto const& known : Known)
+	{
+		if (Score(known.vector).base != known.score)
+			abort();
+	}
+
+	std::string vector = "CVSS:4.0/" + std::string(reinterpret_cast<const char*>(data), size);
+	ScoreResult result = Score(vector);
+	ParsedVector4 parsed = ParseVector4(vector);
+	if ((result.error != parsed.error) || (result.version != CVSSVersion::V4_0))
+		abort();
+	if (result.error != ParseError::None)
+	{
+		if (result.errorOffset + result.errorLength > vector.size())
+			abort();
+		return 0;
+	}
+
+	float scores[3] = { result.base, result.temporal, result.environmental };
+	for (float score : scores)
+	{
+		if ((score < 0) || (score > 10) || (std::fabs(score * 10 - std::round(score * 10)) > 1e-3))
+			abort();
+	}
+
+	CVSS_4_0 cvss(parsed);
+	if ((cvss.GetBaseScore() != result.base) || (cvss.GetTemporalScore() != result.temporal) || (cvss.GetEnvironmentalScore() != result.environmental))
+		abort();
+	if (cvss.GetMacroVector().size() != 6)
+		abort();
+
+	Vector4Metrics base;
+	base.av = parsed.av;
+	base.ac = parsed.ac;
+	base.at = parsed.at;
+	base.pr = parsed.pr;
+	base.ui = parsed.ui;
+	base.vc = parsed.vc;
+	base.vi = parsed.vi;
+	base.va = parsed.va;
+	base.sc = parsed.sc;
+	base.si = parsed.si;
+	base.sa = parsed.sa;
+	if (CVSS_4_0(base).GetEnvironmentalScore() != result.base)
+		abort();
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_2.h"
+#include "../src/cvss_2_engine.h"
+#include "../src/cvss_score.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+//the worked examples of the 2.0 specification, and low requirements that take AdjustedBase below 0
+static const struct
+{
+	const char *vector;
+	float base;
+	float temporal;
+	float environmental;
+} Known[] = {
+	{ "AV:N/AC:L/Au:N/C:N/I:N/A:C/E:F/RL:OF/RC:C/CDP:H/TD:H/CR:M/IR:M/AR:H", 7.8f, 6.4f, 9.2f },
+	{ "AV:N/AC:L/Au:N/C:C/I:C/A:C/E:F/RL:OF/RC:C/CDP:H/TD:H/CR:M/IR:M/AR:L", 10.0f, 8.3f, 9.0f },
+	{ "AV:L/AC:H/Au:N/C:C/I:C/A:C/E:POC/RL:OF/RC:C/CDP:H/TD:H/CR:M/IR:M/AR:M", 6.2f, 4.9f, 7.5f },
+	{ "AV:N/AC:L/Au:N/C:P/I:P/A:P", 7.5f, 7.5f, 7.5f },
+	{ "AV:N/AC:L/Au:N/C:N/I:N/A:N", 0.0f, 0.0f, 0.0f },
+	{ "AV:L/AC:H/Au:M/C:P/I:N/A:N/CR:L", 0.8f, 0.8f, 0.0f },
+	{ "AV:L/AC:H/Au:M/C:P/I:N/A:N/CDP:H/TD:H/CR:L", 0.8f, 0.8f, 5.0f }
+};
+
+//any 2.0 vector that parses scores within 0 - 10 in whole tenths, identically through Score(), ComputeScore()
+//and CVSS_2
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	for (auto const& known : Known)
+	{
+		ScoreResult result = Score(known.vector);
+		if ((result.base != known.base) || (result.temporal != known.temporal) || (result.environmental != known.environmental))
+			abort();
+	}
+
+	std::string vector = "AV:N/AC:L/Au:" + std::string(reinterpret_cast<const char*>(data), size);
+	ScoreResult result = Score(vector);
+	ParsedVector2 parsed = ParseVector2(vector);
+	if ((result.error != parsed.error) || (result.version != CVSSVersion::V2_0))
+		abort();
+	if (result.error != ParseError::None)
+	{
+		if (result.errorOffset + result.errorLength > vector.size())
+			abort();
+		return 0;
+	}
+
+	float scores[3] = { result.base, result.temporal, result.environmental };
+	for (float score : scores)
+	{
+		if ((score < 0) || (score > 10) || (std::fabs(score * 10 - std::round(score * 10)) > 1e-3))
+			abort();
+	}
+
+	ScoreResult computed = ComputeScore(parsed);
+	if ((computed.base != result.base) || (computed.temporal != result.temporal) || (computed.environmental != result.environmental))
+		abort();
+
+	CVSS_2 cvss(parsed);
+	if ((cvss.GetBaseScore() != result.base) || (cvss.GetTemporalScore() != result.temporal) || (cvss.GetEnvironmentalScore() != result.environmental))
+		abort();
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_summary.h"
+#include <cstdlib>
+#include <string_view>
+
+//summarising lines one by one, or in two halves merged afterwards, gives the same summary; its counts agree with
+//each other and its percentiles never decrease
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view text(reinterpret_cast<const char*>(data), size);
+	ScoreSummary whole;
+	ScoreSummary halves[2];
+	uint64_t lines = 0;
+	size_t start = 0;
+	while (start < text.size())
+	{
+		size_t end = text.find('\n', start);
+		if (end == std::string_view::npos)
+			end = text.size();
+		std::string_view line = text.substr(start, end - start);
+		ScoreResult result = Summarize(line, whole);
+		if (Summarize(line, halves[(start * 2 < text.size()) ? 0 : 1]).error != result.error)
+			abort();
+		lines++;
+		start = end + 1;
+	}
+	halves[0].Merge(halves[1]);
+
+	if (whole.GetCount() + whole.GetErrors() != lines)
+		abort();
+	if ((halves[0].GetCount() != whole.GetCount()) || (halves[0].GetErrors() != whole.GetErrors()))
+		abort();
+	ScoreHistogram const *histograms[3][2] = { { &whole.GetBase(), &halves[0].GetBase() }, { &whole.GetTemporal(), &halves[0].GetTemporal() }, { &whole.GetEnvironmental(), &halves[0].GetEnvironmental() } };
+	for (auto const& pair : histograms)
+	{
+		if (pair[0]->GetCount() != whole.GetCount())
+			abort();
+		uint64_t severities = 0;
+		for (size_t severity = 0; severity < SeverityCount; severity++)
+			severities += pair[0]->GetSeverityCount(static_cast<Severity>(severity));
+		if (severities != whole.GetCount())
+			abort();
+		float last = 0;
+		for (double percentile = 0; percentile <= 100; percentile += 12.5)
+		{
+			float score = pair[0]->GetPercentile(percentile);
+			if ((score < last) || (score != pair[1]->GetPercentile(percentile)))
+				abort();
+			last = score;
+		}
+		if ((pair[0]->GetMean() < 0) || (pair[0]->GetMean() > 10))
+			abort();
+	}
+
+	//every base metric of a scored vector is counted once
+	for (size_t metric = 0; metric < SummaryMetricCount; metric++)
+	{
+		uint64_t count = 0;
+		for (size_t value = 0; value < SummaryValueCount; value++)
+		{
+			count += whole.GetMetricCount(metric, value);
+			if (whole.GetMetricCount(metric, value) != halves[0].GetMetricCount(metric, value))
+				abort();
+		}
+		uint64_t expected = 0;
+		if (SummaryMetrics[metric].grammar == VectorGrammar::V2)
+			expected = whole.GetVersionCount(CVSSVersion::V2_0);
+		else if (SummaryMetrics[metric].grammar == VectorGrammar::V3)
+			expected = whole.GetVersionCount(CVSSVersion::V3_0) + whole.GetVersionCount(CVSSVersion::V3_1);
+		else
+			expected = whole.GetVersionCount(CVSSVersion::V4_0);
+		if (count != expected)
+			abort();
+	}
+	return 0;
+}
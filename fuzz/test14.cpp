@@ -0,0 +1,66 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_canonical.h"
+#include "../src/cvss_score.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//a parsed 3.x vector and its canonical string have the same key and scores, the canonical string is its own
+//canonical string, and reversing the components (with the version kept first) or adding placeholders does
+//not change the key
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string vector(reinterpret_cast<const char*>(data), size);
+	ParsedVector parsed = ParseVector(vector);
+	if (parsed.error != ParseError::None)
+		return 0;
+
+	PackedVector key = GetCanonicalKey(parsed);
+	std::string canonical = FormatVector(Canonicalize(parsed));
+	ParsedVector reparsed = ParseVector(canonical);
+	if ((reparsed.error != ParseError::None) || (GetCanonicalKey(reparsed) != key) || (FormatVector(reparsed) != canonical))
+		abort();
+	ScoreResult original = Score(parsed);
+	ScoreResult rewritten = Score(reparsed);
+	if ((original.base != rewritten.base) || (original.temporal != rewritten.temporal) || (original.environmental != rewritten.environmental))
+		abort();
+
+	std::vector<std::string_view> components;
+	std::string_view text(canonical);
+	for (size_t start = 0, end = 0; end != std::string_view::npos; start = end + 1)
+	{
+		end = text.find('/', start);
+		components.push_back(text.substr(start, (end == std::string_view::npos) ? std::string_view::npos : end - start));
+	}
+	std::reverse(components.begin() + 1, components.end());
+	std::string reversed(components[0]);
+	reversed += "/E:X/MAV:X"; //placeholders, overridden by any MAV that follows
+	for (size_t n = 1; n < components.size(); n++)
+		reversed += "/" + std::string(components[n]);
+	if (GetCanonicalKey(ParseVector(reversed)) != key)
+		abort();
+
+	DistinctVectors distinct;
+	if ((distinct.Add(key) != 0) || (distinct.Add(GetCanonicalKey(reparsed)) != 0) || (distinct.GetCount() != 1) || (distinct.GetOccurrences(0) != 2) || (distinct.GetVector(0) != canonical))
+		abort();
+	return 0;
+}
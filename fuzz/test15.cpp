@@ -0,0 +1,56 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_nvd.h"
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<std::string, std::string>> Found;
+
+static Found Scan(std::string_view feed, size_t chunk)
+{
+	Found found;
+	NVDScanner scanner([&found](std::string_view id, std::string_view vector) { found.emplace_back(id, vector); });
+	for (size_t start = 0; start < feed.size(); start += chunk)
+		scanner.Feed(feed.substr(start, chunk));
+	return found;
+}
+
+//the scanner finds the same IDs and vectors however a feed is split into blocks, and finds a vector string
+//(without quotes or escapes) wrapped in a CVE record
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view feed(reinterpret_cast<const char*>(data), size);
+	Found whole = Scan(feed, feed.size() ? feed.size() : 1);
+	if ((Scan(feed, 1) != whole) || (Scan(feed, 2) != whole) || (Scan(feed, size ? 1 + data[0] % 64 : 1) != whole))
+		abort();
+
+	if ((size < 256) && (feed.find_first_of("\"\\") == std::string_view::npos))
+	{
+		std::string record = "{\"cve\":{\"id\" : \"CVE-2024-0001\",\"descriptions\":[{\"value\":\"id: \\\"vectorString\\\"\"}],\"metrics\":{\"cvssData\":{\"version\":\"3.1\",\"vectorString\":\"";
+		record.append(feed);
+		record += "\",\"baseScore\":9.8}}}}";
+		Found expected = { { "CVE-2024-0001", std::string(feed) } };
+		if ((Scan(record, record.size()) != expected) || (Scan(record, 1) != expected))
+			abort();
+	}
+	return 0;
+}
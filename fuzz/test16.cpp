@@ -0,0 +1,95 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss.h"
+#include "../src/cvss_csv.h"
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Row
+{
+	std::string row;
+	std::string ending;
+	std::string field;
+	bool hasField;
+
+	bool operator==(Row const& other) const
+	{
+		return (row == other.row) && (ending == other.ending) && (field == other.field) && (hasField == other.hasField);
+	}
+};
+
+//rows read with the data split into two blocks, the way ParseCSV() reads a stream
+static std::vector<Row> Read(std::string_view data, size_t column, size_t split)
+{
+	std::vector<Row> rows;
+	std::string text(data.substr(0, split));
+	for (bool final : { false, true })
+	{
+		if (final)
+			text.append(data.substr(split));
+		CSVIterator iterator(text, ',', column, final);
+		std::string_view row, ending, field;
+		bool hasField;
+		while (iterator.Next(row, ending, field, hasField))
+			rows.push_back({ std::string(row), std::string(ending), std::string(field), hasField });
+		text.erase(0, iterator.GetPosition());
+	}
+	return rows;
+}
+
+//rows and fields do not depend on where the data is split into blocks, and any bytes written as a quoted field
+//(with doubled quotes) are read back unchanged
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view text(reinterpret_cast<const char*>(data), size);
+	size_t column = size ? data[0] % 4 : 0;
+	std::vector<Row> whole = Read(text, column, size);
+	for (size_t split : { size_t(0), size / 2, size ? size - 1 : 0, size ? 1 + data[size - 1] % size : 0 })
+	{
+		if (Read(text, column, split) != whole)
+			abort();
+	}
+
+	std::string quoted = "a,\"";
+	for (char c : text)
+	{
+		quoted.push_back(c);
+		if (c == '"')
+			quoted.push_back('"');
+	}
+	quoted += "\",b\r\nc";
+	std::vector<Row> rows = Read(quoted, 1, quoted.size() / 2);
+	if ((rows.size() != 2) || !rows[0].hasField || (rows[0].field != text) || (rows[0].ending != "\r\n") || rows[1].hasField)
+		abort();
+
+	//the header is the first row that is not blank
+	static bool checked = false;
+	if (!checked)
+	{
+		std::ostringstream out, err;
+		ParseCSV(std::string_view("\r\n\nName,Vector\nx,CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H\n"), out, err, 1, ',', true);
+		if ((out.str() != "\r\n\nName,Vector,Base,Severity\nx,CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H,9.8,Critical\n") || !err.str().empty())
+			abort();
+		checked = true;
+	}
+	return 0;
+}
@@ -0,0 +1,75 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_server.h"
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+//answers data the way cvssd does: read in blocks of the given size, consumed from the front of a buffer, with
+//answering paused every outputLimit bytes; empty if a request is too long
+static std::string Serve(std::string_view data, size_t block, size_t outputLimit)
+{
+	ScoreSession session(true, true, true);
+	std::string input;
+	std::string output;
+	std::string answers;
+	for (size_t start = 0; start <= data.size(); start += block)
+	{
+		input.append(data.substr(start, block));
+		while (true)
+		{
+			size_t consumed = session.Process(input, output, outputLimit, 0);
+			if (consumed == std::string_view::npos)
+				return std::string();
+			input.erase(0, consumed);
+			answers += output;
+			output.clear();
+			if (consumed == 0)
+				break;
+		}
+	}
+	return answers;
+}
+
+//answers do not depend on how requests are split across reads or how often answering pauses, and a vector
+//sent as a frame gets the same answer as sent as a line
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view requests(reinterpret_cast<const char*>(data), size);
+	std::string whole = Serve(requests, requests.size() + 1, std::string::npos);
+	if ((Serve(requests, 1, 1) != whole) || (Serve(requests, size ? 1 + data[0] % 97 : 1, size ? 1 + data[size - 1] : 1) != whole))
+		abort();
+
+	if ((size <= MaxRequestSize) && (requests.find_first_of(std::string_view("\n\0", 2)) == std::string_view::npos) && (requests != "STATS"))
+	{
+		std::string line(requests);
+		line.push_back('\n');
+		std::string frame;
+		for (size_t n = 0; n < FrameHeaderSize; n++)
+			frame.push_back(static_cast<char>((size >> (8 * (FrameHeaderSize - 1 - n))) & 0xFF));
+		frame.append(requests);
+		std::string lineAnswer = Serve(line, line.size(), std::string::npos);
+		std::string frameAnswer = Serve(frame, frame.size(), std::string::npos);
+		if (!line.empty() && (line[line.size() - 2] == '\r'))
+			return 0; //the line loses its '\r', the frame keeps it
+		if ((lineAnswer.empty()) || (frameAnswer.size() != lineAnswer.size() + FrameHeaderSize - 1) || (frameAnswer.compare(FrameHeaderSize, std::string::npos, lineAnswer, 0, lineAnswer.size() - 1) != 0))
+			abort();
+	}
+	return 0;
+}
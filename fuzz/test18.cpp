@@ -0,0 +1,103 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_canonical.h"
+#include "../src/cvss_packed.h"
+#include "../src/cvss_vector.h"
+#include <cstdlib>
+#include <string>
+
+template<typename T> static bool SameModified(Modified<T> const& a, Modified<T> const& b)
+{
+	return (a.parent == b.parent) && (a.modified == b.modified);
+}
+
+//every field a PackedVector keeps; Unpack() leaves the error fields at their defaults
+static bool Same(ParsedVector const& a, ParsedVector const& b)
+{
+	return (a.version == b.version) && (a.av == b.av) && (a.ac == b.ac) && (a.pr == b.pr) && (a.ui == b.ui) && (a.s == b.s) && (a.c == b.c) && (a.i == b.i) && (a.a == b.a) &&
+		(a.e == b.e) && (a.rl == b.rl) && (a.rc == b.rc) && (a.cr == b.cr) && (a.ir == b.ir) && (a.ar == b.ar) &&
+		SameModified(a.mav, b.mav) && SameModified(a.mac, b.mac) && SameModified(a.mpr, b.mpr) && SameModified(a.mui, b.mui) &&
+		SameModified(a.ms, b.ms) && SameModified(a.mc, b.mc) && SameModified(a.mi, b.mi) && SameModified(a.ma, b.ma);
+}
+
+static void CheckRoundTrip(ParsedVector const& v)
+{
+	PackedVector packed(v);
+	ParsedVector unpacked = packed.Unpack();
+	if (!Same(v, unpacked) || (unpacked.error != ParseError::None) || (PackedVector(unpacked) != packed) || (PackedVector(packed.GetBits()).GetBits() != packed.GetBits()))
+		abort();
+}
+
+template<typename T> static T Pick(unsigned char byte, unsigned count)
+{
+	return static_cast<T>(byte % count);
+}
+
+template<typename T> static Modified<T> PickModified(unsigned char byte, unsigned count)
+{
+	return { Pick<T>(byte >> 1, count), (byte & 1) != 0 };
+}
+
+//PackedVector(v).Unpack() gives back every field of v: a vector built field by field from the input's bytes,
+//the input parsed as a vector, and the same vector with a modified metric set and then reset with X
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	if (size >= 23)
+	{
+		ParsedVector v;
+		v.version = Pick<CVSSVersion>(data[0], 2);
+		v.av = Pick<AttackVector>(data[1], 4);
+		v.ac = Pick<AttackComplexity>(data[2], 2);
+		v.pr = Pick<PrivilegesRequired>(data[3], 3);
+		v.ui = Pick<UserInteraction>(data[4], 2);
+		v.s = Pick<Scope>(data[5], 2);
+		v.c = Pick<Impact>(data[6], 3);
+		v.i = Pick<Impact>(data[7], 3);
+		v.a = Pick<Impact>(data[8], 3);
+		v.e = Pick<ExploitCodeMaturity>(data[9], 5);
+		v.rl = Pick<RemediationLevel>(data[10], 5);
+		v.rc = Pick<ReportConfidence>(data[11], 4);
+		v.cr = Pick<Requirement>(data[12], 4);
+		v.ir = Pick<Requirement>(data[13], 4);
+		v.ar = Pick<Requirement>(data[14], 4);
+		v.mav = PickModified<AttackVector>(data[15], 4);
+		v.mac = PickModified<AttackComplexity>(data[16], 2);
+		v.mpr = PickModified<PrivilegesRequired>(data[17], 3);
+		v.mui = PickModified<UserInteraction>(data[18], 2);
+		v.ms = PickModified<Scope>(data[19], 2);
+		v.mc = PickModified<Impact>(data[20], 3);
+		v.mi = PickModified<Impact>(data[21], 3);
+		v.ma = PickModified<Impact>(data[22], 3);
+		CheckRoundTrip(v);
+	}
+
+	std::string text(reinterpret_cast<const char*>(data), size);
+	ParsedVector parsed = ParseVector(text);
+	if (parsed.error != ParseError::None)
+		return 0;
+	CheckRoundTrip(parsed);
+
+	ParsedVector reset = ParseVector(text + "/MAV:P/MAV:X");
+	if (reset.error != ParseError::None)
+		return 0;
+	CheckRoundTrip(reset);
+	if (reset.mav.modified || (reset.mav.parent != ParsedVector().mav.parent))
+		abort();
+	return 0;
+}
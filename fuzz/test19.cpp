@@ -0,0 +1,90 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_cache.h"
+#include "../src/cvss_batch.h"
+#include "../src/cvss_score.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+//the input's lines are repeated to fill batches ending on and around chunk boundaries, which are scored on pools of
+//several sizes; every result must match Score() of the vector at the same position, and every pool task must run once
+static bool Same(ScoreResult const& a, ScoreResult const& b)
+{
+	return (a.version == b.version) && (a.error == b.error) && (a.errorOffset == b.errorOffset) && (a.errorLength == b.errorLength) &&
+		((a.error != ParseError::None) || ((memcmp(&a.base, &b.base, sizeof(float)) == 0) && (memcmp(&a.temporal, &b.temporal, sizeof(float)) == 0) && (memcmp(&a.environmental, &b.environmental, sizeof(float)) == 0)));
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	static ThreadPool pools[] = { ThreadPool(1), ThreadPool(2), ThreadPool(3), ThreadPool(8) };
+
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	std::vector<std::string_view> lines;
+	size_t start = 0;
+	for (size_t end; (end = input.find('\n', start)) != std::string_view::npos; start = end + 1)
+		lines.push_back(input.substr(start, end - start));
+	lines.push_back(input.substr(start));
+
+	const size_t counts[] = { 0, 1, lines.size(), BatchChunkSize - 1, BatchChunkSize, BatchChunkSize + 1, 3 * BatchChunkSize + lines.size() };
+	std::vector<std::string_view> vectors;
+	std::vector<ScoreResult> expected;
+	std::vector<ScoreResult> results;
+	for (size_t count : counts)
+	{
+		vectors.resize(count);
+		expected.resize(count);
+		for (size_t n = 0; n < count; n++)
+		{
+			vectors[n] = lines[n % lines.size()];
+			expected[n] = Score(vectors[n]);
+		}
+
+		for (ThreadPool &pool : pools)
+		{
+			results.assign(count, ScoreResult());
+			ScoreBatch(vectors.data(), count, results.data(), pool);
+			for (size_t n = 0; n < count; n++)
+				if (!Same(results[n], expected[n]))
+					abort();
+		}
+
+		ScoreCache cache(64);
+		results.assign(count, ScoreResult());
+		ScoreBatch(vectors.data(), count, results.data(), 4, &cache);
+		for (size_t n = 0; n < count; n++)
+			if (!Same(results[n], expected[n]))
+				abort();
+	}
+
+	size_t tasks = (size > 0) ? data[0] : 0;
+	for (ThreadPool &pool : pools)
+	{
+		std::vector<std::atomic<unsigned>> runs(tasks);
+		pool.Run(tasks, [&](size_t task) {
+			runs[task]++;
+		});
+		for (auto const& r : runs)
+			if (r != 1)
+				abort();
+	}
+	return 0;
+}
@@ -0,0 +1,119 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "../src/cvss_table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+//an independent transcription of the 3.x base and temporal formulas, in the baseline's float and double
+//steps, so the tables are not compared against the engine they were built from
+static const float AttackVectorWeights[] = { 0.85f, 0.62f, 0.55f, 0.2f };
+static const float AttackComplexityWeights[] = { 0.77f, 0.44f };
+static const float PrivilegesRequiredWeights[2][3] = { { 0.85f, 0.62f, 0.27f }, { 0.85f, 0.68f, 0.5f } }; //scope unchanged, changed
+static const float UserInteractionWeights[] = { 0.85f, 0.62f };
+static const float ImpactWeights[] = { 0.56f, 0.22f, 0.0f };
+static const float ExploitCodeMaturityWeights[] = { 1.0f, 1.0f, 0.97f, 0.94f, 0.91f };
+static const float RemediationLevelWeights[] = { 1.0f, 1.0f, 0.97f, 0.96f, 0.95f };
+static const float ReportConfidenceWeights[] = { 1.0f, 1.0f, 0.96f, 0.92f };
+
+static float Normalize(float score)
+{
+	return std::min(std::max(score, 0.0f), 10.0f);
+}
+
+static float ReferenceBase(size_t av, size_t ac, size_t pr, size_t ui, size_t s, size_t c, size_t i, size_t a)
+{
+	float iss = 1.0 - ((1.0 - ImpactWeights[c]) * (1.0 - ImpactWeights[i]) * (1.0 - ImpactWeights[a]));
+	float impact = s ? Normalize(7.52 * (iss - 0.029) - (3.25 * pow(iss - 0.02, 15.0))) : Normalize(6.42 * iss);
+	if (impact <= 0.0)
+		return 0;
+	float exploitability = Normalize(8.22 * AttackVectorWeights[av] * AttackComplexityWeights[ac] * PrivilegesRequiredWeights[s][pr] * UserInteractionWeights[ui]);
+	float factor = s ? 1.08 : 1.0;
+	return Normalize(factor * (impact + exploitability));
+}
+
+static bool Same(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+//every one of the BaseTableSize x TemporalTableSize combinations, 3.0 and 3.1 sharing both tables
+static void CheckAll()
+{
+	for (size_t av = 0; av < 4; av++)
+	for (size_t ac = 0; ac < 2; ac++)
+	for (size_t pr = 0; pr < 3; pr++)
+	for (size_t ui = 0; ui < 2; ui++)
+	for (size_t s = 0; s < 2; s++)
+	for (size_t c = 0; c < 3; c++)
+	for (size_t i = 0; i < 3; i++)
+	for (size_t a = 0; a < 3; a++)
+	{
+		size_t b = GetBaseIndex(static_cast<AttackVector>(av), static_cast<AttackComplexity>(ac), static_cast<PrivilegesRequired>(pr), static_cast<UserInteraction>(ui), static_cast<Scope>(s), static_cast<Impact>(c), static_cast<Impact>(i), static_cast<Impact>(a));
+		if (b >= BaseTableSize)
+			abort();
+		float base = ReferenceBase(av, ac, pr, ui, s, c, i, a);
+		if (!Same(LookupBaseScore(b), static_cast<float>(ceil(base * 10.0) / 10.0)))
+			abort();
+
+		for (size_t e = 0; e < 5; e++)
+		for (size_t rl = 0; rl < 5; rl++)
+		for (size_t rc = 0; rc < 4; rc++)
+		{
+			size_t t = GetTemporalIndex(static_cast<ExploitCodeMaturity>(e), static_cast<RemediationLevel>(rl), static_cast<ReportConfidence>(rc));
+			if (t >= TemporalTableSize)
+				abort();
+			float temporal = Normalize(base * ExploitCodeMaturityWeights[e] * RemediationLevelWeights[rl] * ReportConfidenceWeights[rc]);
+			if (!Same(LookupTemporalScore(b, t), static_cast<float>(ceil(temporal * 10.0) / 10.0)))
+				abort();
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	static bool checked = false;
+	if (!checked)
+	{
+		CheckAll();
+		checked = true;
+	}
+
+	//each input also picks one base and one temporal index, which must survive a round trip through their metrics
+	if (size < 3)
+		return 0;
+	size_t b = ((data[0] << 8) | data[1]) % BaseTableSize;
+	size_t t = data[2] % TemporalTableSize;
+	AttackVector av;
+	AttackComplexity ac;
+	PrivilegesRequired pr;
+	UserInteraction ui;
+	Scope s;
+	Impact c, i, a;
+	ExploitCodeMaturity e;
+	RemediationLevel rl;
+	ReportConfidence rc;
+	GetBaseMetrics(b, av, ac, pr, ui, s, c, i, a);
+	GetTemporalMetrics(t, e, rl, rc);
+	if ((GetBaseIndex(av, ac, pr, ui, s, c, i, a) != b) || (GetTemporalIndex(e, rl, rc) != t))
+		abort();
+	return 0;
+}
@@ -0,0 +1,85 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_cache.h"
+#include "../src/cvss.h"
+#include "../src/cvss_mmap.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+//LineIterator must split text into the same lines as getline() with a trailing "\r" removed, MappedFile must map
+//a file holding the text back unchanged, and ParseBatch() over the mapping must write exactly what the istream
+//overload writes; the fixed cases cover CRLF, blank lines, a missing final newline and empty input
+static void Check(std::string const& text)
+{
+	std::istringstream in(text);
+	LineIterator lines(text);
+	std::string expected;
+	std::string_view line;
+	while (std::getline(in, expected))
+	{
+		if (!expected.empty() && (expected.back() == '\r'))
+			expected.pop_back();
+		size_t number = lines.GetLineNumber();
+		if (!lines.Next(line) || (line != expected) || (lines.GetLineNumber() != number + 1) || (line.data() < text.data()) || (line.data() + line.size() > text.data() + text.size()))
+			abort();
+	}
+	if (lines.Next(line))
+		abort();
+
+	char path[] = "/tmp/cvss_test20_XXXXXX";
+	int fd = mkstemp(path);
+	if (fd < 0)
+		return;
+	bool written = (write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+	close(fd);
+	MappedFile file(path);
+	unlink(path);
+	if (!written)
+		return;
+	if (!file.IsOpen() || (file.GetData() != text))
+		abort();
+
+	for (unsigned threads : { 1, 3 })
+	{
+		std::istringstream stream(text);
+		std::ostringstream streamOut, streamErr, mappedOut, mappedErr;
+		int streamRet = ParseBatch(stream, streamOut, streamErr, true, true, true, false, threads);
+		int mappedRet = ParseBatch(file.GetData(), mappedOut, mappedErr, true, true, true, false, threads);
+		if ((streamRet != mappedRet) || (streamOut.str() != mappedOut.str()) || (streamErr.str() != mappedErr.str()))
+			abort();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	static bool checked = false;
+	if (!checked)
+	{
+		for (const char *text : { "", "\n", "\r\n", "\n\n\r\n", "CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H", "CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H\r\n\r\nCVSS:3.0/AV:L/AC:H/PR:H/UI:R/S:C/C:L/I:N/A:N\r", "\nbad\n\nCVSS:3.1/AV:P/AC:H/PR:H/UI:R/S:U/C:N/I:N/A:N\n" })
+			Check(text);
+		checked = true;
+	}
+
+	Check(std::string(reinterpret_cast<const char*>(data), size));
+	return 0;
+}
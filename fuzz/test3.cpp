@@ -0,0 +1,90 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "../src/cvss_3.h"
+#include "../src/cvss_3_1.h"
+#include "../src/cvss_3_engine.h"
+#include "../src/cvss_columns.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//every 23 input bytes describe one vector and its version; all score kernels and CVSS_3_Engine must match
+//the CVSS_3/CVSS_3_1 getters bit for bit, and versions other than 3.0 (4.0 and 2.0 included) must score as 3.1
+static const uint8_t Range[23] = { 4, 2, 3, 2, 2, 3, 3, 3, 5, 5, 4, 4, 4, 4, 5, 3, 4, 3, 3, 4, 4, 4, 4 };
+
+static bool Same(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+template<typename T> static Modified<T> ToModified(uint8_t value)
+{
+	return { static_cast<T>((value == MetricNotDefined) ? 0 : value), value != MetricNotDefined };
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	size_t count = size / 23;
+	std::vector<std::vector<uint8_t>> columns(23, std::vector<uint8_t>(count));
+	for (size_t n = 0; n < count; n++)
+		for (size_t k = 0; k < 23; k++)
+		{
+			//the last value of each modified metric's range stands for "X"
+			uint8_t value = data[n * 23 + k] % Range[k];
+			columns[k][n] = ((k >= 14) && (k < 22) && (value == Range[k] - 1)) ? MetricNotDefined : value;
+		}
+
+	MetricColumns m;
+	m.count = count;
+	const uint8_t **fields[23] = { &m.av, &m.ac, &m.pr, &m.ui, &m.s, &m.c, &m.i, &m.a, &m.e, &m.rl, &m.rc, &m.cr, &m.ir, &m.ar, &m.mav, &m.mac, &m.mpr, &m.mui, &m.ms, &m.mc, &m.mi, &m.ma, &m.version };
+	for (size_t k = 0; k < 23; k++)
+		*fields[k] = columns[k].data();
+
+	for (ScoreKernel kernel : { ScoreKernel::Scalar, ScoreKernel::SSE2, ScoreKernel::AVX2, ScoreKernel::NEON })
+	{
+		std::vector<float> base(count), temporal(count), environmental(count);
+		ScoreColumns(m, base.data(), temporal.data(), environmental.data(), kernel);
+		for (size_t n = 0; n < count; n++)
+		{
+			CVSS_3_1 cvss31(static_cast<AttackVector>(m.av[n]), static_cast<AttackComplexity>(m.ac[n]), static_cast<PrivilegesRequired>(m.pr[n]), static_cast<UserInteraction>(m.ui[n]), static_cast<Scope>(m.s[n]), static_cast<Impact>(m.c[n]), static_cast<Impact>(m.i[n]), static_cast<Impact>(m.a[n]), static_cast<ExploitCodeMaturity>(m.e[n]), static_cast<RemediationLevel>(m.rl[n]), static_cast<ReportConfidence>(m.rc[n]), static_cast<Requirement>(m.cr[n]), static_cast<Requirement>(m.ir[n]), static_cast<Requirement>(m.ar[n]), ToModified<AttackVector>(m.mav[n]), ToModified<AttackComplexity>(m.mac[n]), ToModified<PrivilegesRequired>(m.mpr[n]), ToModified<UserInteraction>(m.mui[n]), ToModified<Scope>(m.ms[n]), ToModified<Impact>(m.mc[n]), ToModified<Impact>(m.mi[n]), ToModified<Impact>(m.ma[n]));
+			CVSS_3 cvss30(static_cast<AttackVector>(m.av[n]), static_cast<AttackComplexity>(m.ac[n]), static_cast<PrivilegesRequired>(m.pr[n]), static_cast<UserInteraction>(m.ui[n]), static_cast<Scope>(m.s[n]), static_cast<Impact>(m.c[n]), static_cast<Impact>(m.i[n]), static_cast<Impact>(m.a[n]), static_cast<ExploitCodeMaturity>(m.e[n]), static_cast<RemediationLevel>(m.rl[n]), static_cast<ReportConfidence>(m.rc[n]), static_cast<Requirement>(m.cr[n]), static_cast<Requirement>(m.ir[n]), static_cast<Requirement>(m.ar[n]), ToModified<AttackVector>(m.mav[n]), ToModified<AttackComplexity>(m.mac[n]), ToModified<PrivilegesRequired>(m.mpr[n]), ToModified<UserInteraction>(m.mui[n]), ToModified<Scope>(m.ms[n]), ToModified<Impact>(m.mc[n]), ToModified<Impact>(m.mi[n]), ToModified<Impact>(m.ma[n]));
+			CVSS_3_1 &cvss = (m.version[n] == static_cast<uint8_t>(CVSSVersion::V3_0)) ? cvss30 : cvss31;
+			if (!Same(base[n], cvss.GetBaseScore()) || !Same(temporal[n], cvss.GetTemporalScore()) || !Same(environmental[n], cvss.GetEnvironmentalScore()))
+				abort();
+			if (!Same(cvss30.GetBaseScore(), cvss31.GetBaseScore()) || !Same(cvss30.GetTemporalScore(), cvss31.GetTemporalScore()))
+				abort();
+
+			ParsedVector v;
+			v.av = static_cast<AttackVector>(m.av[n]); v.ac = static_cast<AttackComplexity>(m.ac[n]); v.pr = static_cast<PrivilegesRequired>(m.pr[n]); v.ui = static_cast<UserInteraction>(m.ui[n]);
+			v.s = static_cast<Scope>(m.s[n]); v.c = static_cast<Impact>(m.c[n]); v.i = static_cast<Impact>(m.i[n]); v.a = static_cast<Impact>(m.a[n]);
+			v.e = static_cast<ExploitCodeMaturity>(m.e[n]); v.rl = static_cast<RemediationLevel>(m.rl[n]); v.rc = static_cast<ReportConfidence>(m.rc[n]);
+			v.cr = static_cast<Requirement>(m.cr[n]); v.ir = static_cast<Requirement>(m.ir[n]); v.ar = static_cast<Requirement>(m.ar[n]);
+			v.mav = ToModified<AttackVector>(m.mav[n]); v.mac = ToModified<AttackComplexity>(m.mac[n]); v.mpr = ToModified<PrivilegesRequired>(m.mpr[n]); v.mui = ToModified<UserInteraction>(m.mui[n]);
+			v.ms = ToModified<Scope>(m.ms[n]); v.mc = ToModified<Impact>(m.mc[n]); v.mi = ToModified<Impact>(m.mi[n]); v.ma = ToModified<Impact>(m.ma[n]);
+			CVSS_3_Engine<CVSSVersion::V3_0> engine30(v);
+			CVSS_3_Engine<CVSSVersion::V3_1> engine31(v);
+			if (!Same(engine30.GetBaseScore(), cvss30.GetBaseScore()) || !Same(engine30.GetTemporalScore(), cvss30.GetTemporalScore()) || !Same(engine30.GetEnvironmentalScore(), cvss30.GetEnvironmentalScore()))
+				abort();
+			if (!Same(engine31.GetBaseScore(), cvss31.GetBaseScore()) || !Same(engine31.GetTemporalScore(), cvss31.GetTemporalScore()) || !Same(engine31.GetEnvironmentalScore(), cvss31.GetEnvironmentalScore()))
+				abort();
+		}
+	}
+	return 0;
+}
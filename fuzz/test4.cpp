@@ -0,0 +1,60 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_cache.h"
+#include "../src/cvss_score.h"
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+//each input line is scored twice through a deliberately tiny cache, so lines both hit and evict each other;
+//every result must match an uncached Score()
+static bool Same(ScoreResult const& a, ScoreResult const& b)
+{
+	return (a.version == b.version) && (a.error == b.error) && (a.errorOffset == b.errorOffset) && (a.errorLength == b.errorLength) &&
+		((a.error != ParseError::None) || ((memcmp(&a.base, &b.base, sizeof(float)) == 0) && (memcmp(&a.temporal, &b.temporal, sizeof(float)) == 0) && (memcmp(&a.environmental, &b.environmental, sizeof(float)) == 0)));
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	std::vector<std::string_view> lines;
+	size_t start = 0;
+	for (size_t end; (end = input.find('\n', start)) != std::string_view::npos; start = end + 1)
+		lines.push_back(input.substr(start, end - start));
+	lines.push_back(input.substr(start));
+
+	ScoreCache cache(4, 2);
+	for (int pass = 0; pass < 2; pass++)
+		for (auto line : lines)
+			if (!Same(cache.Score(line), Score(line)))
+				abort();
+	if (cache.GetHits() + cache.GetMisses() > 2 * lines.size())
+		abort();
+
+	//the requested capacity bounds the entries, however many shards there are
+	size_t capacity = (size > 0) ? data[0] * 7 + 1 : 1;
+	for (unsigned shards : { 0u, 1u, 3u, 64u })
+	{
+		ScoreCache sized(capacity, shards);
+		if ((sized.GetCapacity() == 0) || (sized.GetCapacity() > capacity))
+			abort();
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_2_engine.h"
+#include "../src/cvss_3_engine.h"
+#include "../src/cvss_4_engine.h"
+#include "../src/cvss_score.h"
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+//the constexpr parser and engine of the vector's grammar, run at runtime, must agree with the table-driven Score()
+static bool Same(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	VectorGrammar grammar = GetVectorGrammar(input);
+	ScoreResult computed;
+	if (grammar == VectorGrammar::V4)
+		computed = ComputeScore(ParseVector4(input));
+	else if (grammar == VectorGrammar::V2)
+		computed = ComputeScore(ParseVector2(input));
+	else
+		computed = ComputeScore(ParseVector(input));
+	ScoreResult looked = Score(input);
+	if ((computed.error != looked.error) || (computed.errorOffset != looked.errorOffset) || (computed.errorLength != looked.errorLength))
+		abort();
+	if ((computed.error == ParseError::None) && (!Same(computed.base, looked.base) || !Same(computed.temporal, looked.temporal) || !Same(computed.environmental, looked.environmental)))
+		abort();
+	return 0;
+}
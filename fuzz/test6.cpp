@@ -0,0 +1,81 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_3_engine.h"
+#include "../src/cvss_3_incremental.h"
+#include <cstdlib>
+#include <cstring>
+
+//each pair of input bytes is one setter call (which metric, which value, base or modified); after every call the
+//incremental scores must match a full CVSS_3_Engine rescore of the same vector, for both versions
+static bool Same(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+template<CVSSVersion V> static void Apply(CVSS_3_Incremental<V> &incremental, unsigned char op, unsigned char arg)
+{
+	bool modified = (arg & 0x80) != 0;
+	switch (op % 22)
+	{
+	case 0: incremental.SetAttackVector(static_cast<AttackVector>(arg % 4), modified); break;
+	case 1: incremental.SetAttackComplexity(static_cast<AttackComplexity>(arg % 2), modified); break;
+	case 2: incremental.SetPrivilegesRequired(static_cast<PrivilegesRequired>(arg % 3), modified); break;
+	case 3: incremental.SetUserInteraction(static_cast<UserInteraction>(arg % 2), modified); break;
+	case 4: incremental.SetScope(static_cast<Scope>(arg % 2), modified); break;
+	case 5: incremental.SetConfidentiality(static_cast<Impact>(arg % 3), modified); break;
+	case 6: incremental.SetIntegrity(static_cast<Impact>(arg % 3), modified); break;
+	case 7: incremental.SetAvailability(static_cast<Impact>(arg % 3), modified); break;
+	case 8: incremental.ClearModifiedAttackVector(); break;
+	case 9: incremental.ClearModifiedAttackComplexity(); break;
+	case 10: incremental.ClearModifiedPrivilegesRequired(); break;
+	case 11: incremental.ClearModifiedUserInteraction(); break;
+	case 12: incremental.ClearModifiedScope(); break;
+	case 13: incremental.ClearModifiedConfidentiality(); break;
+	case 14: incremental.ClearModifiedIntegrity(); break;
+	case 15: incremental.ClearModifiedAvailability(); break;
+	case 16: incremental.SetConfidentialityRequirement(static_cast<Requirement>(arg % 4)); break;
+	case 17: incremental.SetIntegrityRequirement(static_cast<Requirement>(arg % 4)); break;
+	case 18: incremental.SetAvailabilityRequirement(static_cast<Requirement>(arg % 4)); break;
+	case 19: incremental.SetExploitCodeMaturity(static_cast<ExploitCodeMaturity>(arg % 5)); break;
+	case 20: incremental.SetRemediationLevel(static_cast<RemediationLevel>(arg % 5)); break;
+	case 21: incremental.SetReportConfidence(static_cast<ReportConfidence>(arg % 4)); break;
+	}
+}
+
+template<CVSSVersion V> static void Check(const unsigned char *data, unsigned long size)
+{
+	CVSS_3_Incremental<V> incremental;
+	for (unsigned long n = 0; n + 1 < size; n += 2)
+	{
+		Apply(incremental, data[n], data[n + 1]);
+		CVSS_3_Engine<V> engine(incremental.GetVector());
+		for (bool modified : { false, true })
+			if (!Same(incremental.GetImpactSubScore(modified), engine.GetImpactSubScore(modified)) || !Same(incremental.GetImpact(modified), engine.GetImpact(modified)) || !Same(incremental.GetExploitability(modified), engine.GetExploitability(modified)))
+				abort();
+		if (!Same(incremental.GetBaseScore(), engine.GetBaseScore()) || !Same(incremental.GetTemporalScore(), engine.GetTemporalScore()) || !Same(incremental.GetEnvironmentalScore(), engine.GetEnvironmentalScore()))
+			abort();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	Check<CVSSVersion::V3_0>(data, size);
+	Check<CVSSVersion::V3_1>(data, size);
+	return 0;
+}
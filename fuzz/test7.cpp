@@ -0,0 +1,56 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_profile.h"
+#include "../src/cvss_score.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+//the first input line is a profile and the rest are vectors; overlaying the profile must score the same as
+//appending it to the vector, since later components override earlier ones
+static bool Same(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	size_t end = input.find('\n');
+	std::string_view text = input.substr(0, end);
+	EnvironmentalProfile profile;
+	if ((end == std::string_view::npos) || (profile.Parse(text) != ParseError::None))
+		return 0;
+
+	for (size_t start = end + 1; start <= input.size(); start = end + 1)
+	{
+		end = input.find('\n', start);
+		std::string_view line = input.substr(start, (end == std::string_view::npos) ? std::string_view::npos : end - start);
+		ScoreResult overlaid = profile.Score(line);
+		ScoreResult appended = Score(std::string(line) + "/" + std::string(text));
+		if ((overlaid.error == ParseError::None) != (appended.error == ParseError::None))
+			abort();
+		if ((overlaid.error == ParseError::None) && (!Same(overlaid.base, appended.base) || !Same(overlaid.temporal, appended.temporal) || !Same(overlaid.environmental, appended.environmental)))
+			abort();
+		if (end == std::string_view::npos)
+			break;
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_binary.h"
+#include "../src/cvss_packed.h"
+#include "../src/cvss_score.h"
+#include "../src/cvss_vector.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+//one vector per line; records written by BinaryBlockWriter must read back through ScoreFile as the scores of
+//each line, and arbitrary bytes must never be accepted as a file with records beyond its end
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	std::string raw(input);
+	ScoreFile file;
+	if (file.Load(raw) && (file.GetCount() * 12 > raw.size()))
+		abort();
+
+	std::string buffer;
+	AppendBinaryHeader(buffer);
+	BinaryBlockWriter writer;
+	size_t count = 0;
+	for (size_t start = 0, end = 0; start <= input.size(); start = end + 1)
+	{
+		end = input.find('\n', start);
+		if (end == std::string_view::npos)
+			end = input.size();
+		std::string_view line = input.substr(start, end - start);
+		if (GetVectorGrammar(line) != VectorGrammar::V3)
+		{
+			//as FormatBinaryBatch() writes them: scored, without a packed vector
+			ScoreResult result = Score(line);
+			if (result.error == ParseError::None)
+				writer.AddUnpacked(result);
+			else
+				writer.AddUnscored();
+		}
+		else
+		{
+			ParsedVector v = ParseVector(line);
+			if (v.error == ParseError::None)
+				writer.Add(PackedVector(v), Score(v));
+			else
+				writer.AddUnscored();
+		}
+		count++;
+		if (writer.GetCount() == BinaryBlockRecords)
+			writer.AppendTo(buffer);
+	}
+	if (writer.GetCount() > 0)
+		writer.AppendTo(buffer);
+
+	if (!file.Load(buffer) || (file.GetCount() != count))
+		abort();
+	size_t n = 0;
+	for (size_t start = 0, end = 0; start <= input.size(); start = end + 1, n++)
+	{
+		end = input.find('\n', start);
+		if (end == std::string_view::npos)
+			end = input.size();
+		std::string_view line = input.substr(start, end - start);
+		ScoreResult result = Score(line);
+		if (file.IsScored(n) != (result.error == ParseError::None))
+			abort();
+		if (!file.IsScored(n))
+			continue;
+		if (file.IsPacked(n) != (GetVectorGrammar(line) == VectorGrammar::V3))
+			abort();
+		if ((file.IsPacked(n) && (file.GetVector(n) != PackedVector(ParseVector(line)))) || (file.GetSeverity(n) != GetSeverity(result.base)))
+			abort();
+		if ((lround(file.GetBaseScore(n) * 10) != lround(result.base * 10)) || (lround(file.GetTemporalScore(n) * 10) != lround(result.temporal * 10)) || (lround(file.GetEnvironmentalScore(n) * 10) != lround(result.environmental * 10)))
+			abort();
+	}
+	return 0;
+}
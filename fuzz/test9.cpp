@@ -0,0 +1,93 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "../src/cvss_3_engine.h"
+#include "../src/cvss_3_integer.h"
+#include "../src/cvss_table.h"
+#include "../src/cvss_vector.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+//the integer engine must agree with the float engine everywhere except where float error leaves the float
+//engine's unrounded score just above a tenth the exact score sits on, which its Ceil then rounds a whole tenth up
+static bool Agree(float rounded, float unrounded, unsigned tenths)
+{
+	float exact = tenths / 10.0f;
+	if (memcmp(&rounded, &exact, sizeof(float)) == 0)
+		return true;
+	return (lround(rounded * 10) == tenths + 1) && (std::fabs(unrounded * 10 - tenths) < 1e-3);
+}
+
+template<CVSSVersion V> static void Check(ParsedVector const& v)
+{
+	CVSS_3_Engine<V> f(v);
+	CVSS_3_IntegerEngine<V> n(v);
+	if (!Agree(f.GetBaseScore(), f.GetBaseScore(false, false), n.GetBaseScore()) || !Agree(f.GetTemporalScore(), f.GetTemporalScore(false), n.GetTemporalScore()) || !Agree(f.GetEnvironmentalScore(), f.GetEnvironmentalScore(false), n.GetEnvironmentalScore()))
+		abort();
+}
+
+//every base and temporal combination, and every modified base metric and requirement combination, of both versions
+template<CVSSVersion V> static void CheckAll()
+{
+	const Requirement requirements[] = { Requirement::Low, Requirement::Medium, Requirement::High };
+	for (size_t baseIndex = 0; baseIndex < BaseTableSize; baseIndex++)
+	{
+		ParsedVector v;
+		v.version = V;
+		GetBaseMetrics(baseIndex, v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a);
+		for (size_t temporalIndex = 0; temporalIndex < TemporalTableSize; temporalIndex++)
+		{
+			GetTemporalMetrics(temporalIndex, v.e, v.rl, v.rc);
+			Check<V>(v);
+		}
+
+		ParsedVector m;
+		m.version = V;
+		m.mav.modified = m.mac.modified = m.mpr.modified = m.mui.modified = m.ms.modified = m.mc.modified = m.mi.modified = m.ma.modified = true;
+		GetBaseMetrics(baseIndex, m.mav.parent, m.mac.parent, m.mpr.parent, m.mui.parent, m.ms.parent, m.mc.parent, m.mi.parent, m.ma.parent);
+		for (size_t r = 0; r < RequirementTableSize; r++)
+		{
+			m.cr = requirements[r % 3];
+			m.ir = requirements[(r / 3) % 3];
+			m.ar = requirements[r / 9];
+			Check<V>(m);
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+	static bool checked = false;
+	if (!checked)
+	{
+		CheckAll<CVSSVersion::V3_0>();
+		CheckAll<CVSSVersion::V3_1>();
+		checked = true;
+	}
+
+	ParsedVector v = ParseVector(std::string_view(reinterpret_cast<const char*>(data), size));
+	if (v.error != ParseError::None)
+		return 0;
+	if (v.version == CVSSVersion::V3_0)
+		Check<CVSSVersion::V3_0>(v);
+	else
+		Check<CVSSVersion::V3_1>(v);
+	return 0;
+}
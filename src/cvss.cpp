@@ -18,740 +18,711 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "cvss.h"
-#include "cvss_3.h"
-#include "cvss_3_1.h"
+#include "cvss_3_engine.h"
+#include "cvss_batch.h"
+#include "cvss_binary.h"
+#include "cvss_cache.h"
+#include "cvss_canonical.h"
+#include "cvss_csv.h"
+#include "cvss_mmap.h"
+#include "cvss_nvd.h"
+#include "cvss_profile.h"
+#include "cvss_score.h"
+#include "cvss_stats.h"
+#include "cvss_summary.h"
+#include "cvss_vector.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace std;
 
-string GetValue(string component)
+string GetErrorMessage(string_view toParse, ParseError error, size_t offset, size_t length)
 {
-	size_t tmpPos = component.find(":");
-	size_t tmpLen = component.length();
-	if ((tmpPos != string::npos) && (tmpPos < tmpLen))
+	string ret = ParseErrorString(error);
+	ret += (error == ParseError::UnsupportedVersion) ? " " : ": ";
+	ret.append(toParse.substr(offset, length));
+	return ret;
+}
+
+//append a rounded score to the buffer without going through iostreams
+void AppendScore(string &buffer, float score)
+{
+	long tenths = lround(score * 10.0);
+	buffer.append(to_string(tenths / 10));
+	if (tenths % 10 != 0)
 	{
-		return component.substr(tmpPos + 1);
+		buffer.push_back('.');
+		buffer.push_back(static_cast<char>('0' + (tenths % 10)));
 	}
-	return "";
 }
 
-int Parse(string const& toParse, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors)
+int Parse(string const& toParse, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, EnvironmentalProfile const *profile)
 {
-	//CVSS 3.1
-	AttackVector av = AttackVector::Network;
-	AttackComplexity ac = AttackComplexity::Low;
-	PrivilegesRequired pr = PrivilegesRequired::None;
-	UserInteraction ui = UserInteraction::None;
-	Scope s = Scope::Unchanged;
-	Impact c = Impact::High;
-	Impact i = Impact::High;;
-	Impact a = Impact::High;;
-	ExploitCodeMaturity e = ExploitCodeMaturity::NotDefined;
-	RemediationLevel rl = RemediationLevel::NotDefined;
-	ReportConfidence rc = ReportConfidence::NotDefined;
-	Requirement cr = Requirement::NotDefined;
-	Requirement ir = Requirement::NotDefined;
-	Requirement ar = Requirement::NotDefined;
-	Modified<AttackVector> mav = { AttackVector::Network, false };
-	Modified<AttackComplexity> mac = { AttackComplexity::Low, false };
-	Modified<PrivilegesRequired> mpr = { PrivilegesRequired::Low, false };
-	Modified<UserInteraction> mui = { UserInteraction::None, false };
-	Modified<Scope> ms = { Scope::Unchanged, false };
-	Modified<Impact> mc = { Impact::High, false };
-	Modified<Impact> mi = { Impact::High, false };
-	Modified<Impact> ma = { Impact::High, false };
-
-	string tmpCvssVersion = "3.1";
-	vector<string> components;
-	size_t start = 0;
-	for (size_t pos = toParse.find("/", start); pos != string::npos; pos = toParse.find("/", start))
+	//scored on the stack; a single vector is not worth building the lookup tables for
+	ScoreResult result;
+	VectorGrammar grammar = GetVectorGrammar(toParse);
+	if (grammar == VectorGrammar::V4)
 	{
-		components.push_back(toParse.substr(start, pos - start));
-		start = pos + 1;
+		result = Score(InstrumentedParseVector4(toParse));
 	}
-	components.push_back(toParse.substr(start));
-	for (auto j : components)
+	else if (grammar == VectorGrammar::V2)
 	{
-		if (j.rfind("CVSS", 0) == 0) // CVSS Version
-		{
-			string cvssVersion = GetValue(j);
-			if (cvssVersion.rfind("3.1", 0) == 0)
-			{
-				tmpCvssVersion = "3.1";
-				continue;
-			}
-			else if (cvssVersion.rfind("3.0", 0) == 0)
-			{
-				tmpCvssVersion = "3.0";
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unsupported CVSS version " << cvssVersion << endl;
-				return EXIT_FAILURE;
-			}
-		}
-		else if (j.rfind("AV:", 0) == 0) // Attack Vector (AV)
+		result = Score(InstrumentedParseVector2(toParse));
+	}
+	else
+	{
+		ParsedVector v = InstrumentedParseVector(toParse);
+		if (profile)
+			profile->Apply(v);
+		CVSS_STAGE_TIMER(Stage::Score);
+		result = ComputeScore(v);
+	}
+	if (result.error != ParseError::None)
+	{
+		if (!suppressErrors)
+			cerr << GetErrorMessage(toParse, result.error, result.errorOffset, result.errorLength) << endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!baseScore && !temporalScore && !environmentalScore)
+		baseScore = true;
+	
+	if (baseScore)
+	{
+		if (temporalScore || environmentalScore)
+			cout << "Base: ";
+		cout << result.base << endl;
+	}
+
+	if (temporalScore)
+	{
+		if (baseScore || environmentalScore)
+			cout << "Temporal: ";
+		cout << result.temporal << endl;
+	}
+
+	if (environmentalScore)
+	{
+		if (baseScore || temporalScore)
+			cout << "Environmental: ";
+		cout << result.environmental << endl;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+//score lines[0 .. count - 1] into one output line each; errors are numbered from firstLine
+bool FormatBatch(string_view const *lines, size_t count, size_t firstLine, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, ScoreCache *cache, EnvironmentalProfile const *profile, string &output, string &errors)
+{
+	bool ret = true;
+	for (size_t n = 0; n < count; n++)
+	{
+		//every input line gets exactly one output line; errors leave it blank
+		if (!lines[n].empty())
 		{
-			string attackVector = GetValue(j);
-			if (attackVector.compare("N") == 0)
-			{
-				av = AttackVector::Network;
-				continue;
-			}
-			else if (attackVector.compare("A") == 0)
-			{
-				av = AttackVector::Adjacent;
-				continue;
-			}
-			else if (attackVector.compare("P") == 0)
-			{
-				av = AttackVector::Physical;
-				continue;
+			ScoreResult result = cache ? cache->Score(lines[n]) : (profile ? profile->Score(lines[n]) : Score(lines[n]));
+			if (result.error == ParseError::None)
+			{
+				CVSS_STAGE_TIMER(Stage::Format);
+				if (baseScore)
+				{
+					AppendScore(output, result.base);
+				}
+				if (temporalScore)
+				{
+					if (baseScore)
+						output.push_back('\t');
+					AppendScore(output, result.temporal);
+				}
+				if (environmentalScore)
+				{
+					if (baseScore || temporalScore)
+						output.push_back('\t');
+					AppendScore(output, result.environmental);
+				}
 			}
 			else
 			{
+				ret = false;
 				if (!suppressErrors)
-					cerr << "Unknown Attack Vector: " << attackVector << endl;
-				return EXIT_FAILURE;
+					errors += "Line " + to_string(firstLine + n) + ": " + GetErrorMessage(lines[n], result.error, result.errorOffset, result.errorLength) + '\n';
 			}
 		}
-		else if (j.rfind("AC:", 0) == 0) // Attack Complexity (AC)
+		output.push_back('\n');
+	}
+	return ret;
+}
+
+//score lines[0 .. count - 1] into one block of binary records; errors are numbered from firstLine
+bool FormatBinaryBatch(string_view const *lines, size_t count, size_t firstLine, bool suppressErrors, EnvironmentalProfile const *profile, string &output, string &errors)
+{
+	bool ret = true;
+	BinaryBlockWriter writer;
+	for (size_t n = 0; n < count; n++)
+	{
+		//every input line gets exactly one record; blank and invalid lines are left unscored
+		if (lines[n].empty())
 		{
-			string attackComplexity = GetValue(j);
-			if (attackComplexity.compare("L") == 0)
-			{
-				ac = AttackComplexity::Low;
-				continue;
-			}
-			else if (attackComplexity.compare("H") == 0)
-			{
-				ac = AttackComplexity::High;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Attack Complexity: " << attackComplexity << endl;
-				return EXIT_FAILURE;
-			}
+			writer.AddUnscored();
+			continue;
 		}
-		else if (j.rfind("PR:", 0) == 0) // Privileges Required (PR)
+
+		//2.0 and 4.0 vectors do not fit a PackedVector, so only their scores are kept
+		if (GetVectorGrammar(lines[n]) != VectorGrammar::V3)
 		{
-			string privilegesRequired = GetValue(j);
-			if (privilegesRequired.compare("N") == 0)
-			{
-				pr = PrivilegesRequired::None;
-				continue;
-			}
-			else if (privilegesRequired.compare("L") == 0)
-			{
-				pr = PrivilegesRequired::Low;
-				continue;
-			}
-			else if (privilegesRequired.compare("H") == 0)
-			{
-				pr = PrivilegesRequired::High;
-				continue;
-			}
-			else
+			ScoreResult result = Score(lines[n]);
+			if (result.error != ParseError::None)
 			{
+				ret = false;
 				if (!suppressErrors)
-					cerr << "Unknown Privileges Required: " << privilegesRequired << endl;
-				return EXIT_FAILURE;
-			}
-		}
-		else if (j.rfind("UI:", 0) == 0) // User Interaction (UI)
-		{
-			string userInteraction = GetValue(j);
-			if (userInteraction.compare("N") == 0)
-			{
-				ui = UserInteraction::None;
-				continue;
-			}
-			else if (userInteraction.compare("R") == 0)
-			{
-				ui = UserInteraction::Required;
+					errors += "Line " + to_string(firstLine + n) + ": " + GetErrorMessage(lines[n], result.error, result.errorOffset, result.errorLength) + '\n';
+				writer.AddUnscored();
 				continue;
 			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown User Interaction: " << userInteraction << endl;
-				return EXIT_FAILURE;
-			}
+			CVSS_STAGE_TIMER(Stage::Format);
+			writer.AddUnpacked(result);
+			continue;
 		}
-		else if (j.rfind("S:", 0) == 0) // Scope (S)
+
+		ParsedVector v = InstrumentedParseVector(lines[n]);
+		if (v.error != ParseError::None)
 		{
-			string scope = GetValue(j);
-			if (scope.compare("U") == 0)
-			{
-				s = Scope::Unchanged;
-				continue;
-			}
-			else if (scope.compare("C") == 0)
-			{
-				s = Scope::Changed;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Scope: " << scope << endl;
-				return EXIT_FAILURE;
-			}
+			ret = false;
+			if (!suppressErrors)
+				errors += "Line " + to_string(firstLine + n) + ": " + GetErrorMessage(lines[n], v.error, v.errorOffset, v.errorLength) + '\n';
+			writer.AddUnscored();
+			continue;
 		}
-		else if (j.rfind("C:", 0) == 0) // Confidentiality (C)
+
+		//the record holds the vector as scored, with any profile overlaid
+		ScoreResult result = profile ? profile->Score(v) : Score(v);
+		if (profile)
+			profile->Apply(v);
+		CVSS_STAGE_TIMER(Stage::Format);
+		writer.Add(PackedVector(v), result);
+	}
+	writer.AppendTo(output);
+	return ret;
+}
+
+//summarise lines[0 .. count - 1] instead of writing their scores; errors are numbered from firstLine
+bool SummarizeLines(string_view const *lines, size_t count, size_t firstLine, bool suppressErrors, EnvironmentalProfile const *profile, ScoreSummary &summary, string &errors)
+{
+	bool ret = true;
+	for (size_t n = 0; n < count; n++)
+	{
+		//blank lines are skipped, as in the other outputs
+		if (lines[n].empty())
+			continue;
+		ScoreResult result = Summarize(lines[n], summary, profile);
+		if (result.error != ParseError::None)
 		{
-			string confidentiality = GetValue(j);
-			if (confidentiality.compare("H") == 0)
-			{
-				c = Impact::High;
-				continue;
-			}
-			else if (confidentiality.compare("L") == 0)
-			{
-				c = Impact::Low;
-				continue;
-			}
-			else if (confidentiality.compare("N") == 0)
-			{
-				c = Impact::None;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Confidentiality: " << confidentiality << endl;
-				return EXIT_FAILURE;
-			}
+			ret = false;
+			if (!suppressErrors)
+				errors += "Line " + to_string(firstLine + n) + ": " + GetErrorMessage(lines[n], result.error, result.errorOffset, result.errorLength) + '\n';
 		}
-		else if (j.rfind("I:", 0) == 0) // Integrity (I)
+	}
+	return ret;
+}
+
+//canonical key of a 3.x line; blank and invalid lines have none, and 2.0 and 4.0 lines are keyed by their text
+const uint64_t NoCanonicalKey = ~uint64_t(0);
+const uint64_t TextCanonicalKey = ~uint64_t(0) - 1;
+
+//key lines[0 .. count - 1] into keys for --distinct; errors are numbered from firstLine
+bool CanonicalizeLines(string_view const *lines, size_t count, size_t firstLine, bool suppressErrors, uint64_t *keys, string &errors)
+{
+	bool ret = true;
+	for (size_t n = 0; n < count; n++)
+	{
+		keys[n] = NoCanonicalKey;
+		if (lines[n].empty())
+			continue;
+
+		ParseError error = ParseError::None;
+		size_t offset = 0;
+		size_t length = 0;
+		VectorGrammar grammar = GetVectorGrammar(lines[n]);
+		if (grammar == VectorGrammar::V3)
 		{
-			string integrity = GetValue(j);
-			if (integrity.compare("H") == 0)
-			{
-				i = Impact::High;
-				continue;
-			}
-			else if (integrity.compare("L") == 0)
-			{
-				i = Impact::Low;
-				continue;
-			}
-			else if (integrity.compare("N") == 0)
-			{
-				i = Impact::None;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Integrity: " << integrity << endl;
-				return EXIT_FAILURE;
-			}
+			ParsedVector v = InstrumentedParseVector(lines[n]);
+			if (v.error == ParseError::None)
+				keys[n] = GetCanonicalKey(v).GetBits();
+			error = v.error;
+			offset = v.errorOffset;
+			length = v.errorLength;
 		}
-		else if (j.rfind("A:", 0) == 0) // Availability (A)
+		else if (grammar == VectorGrammar::V2)
 		{
-			string availability = GetValue(j);
-			if (availability.compare("H") == 0)
-			{
-				a = Impact::High;
-				continue;
-			}
-			else if (availability.compare("L") == 0)
-			{
-				a = Impact::Low;
-				continue;
-			}
-			else if (availability.compare("N") == 0)
-			{
-				a = Impact::None;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Availability: " << availability << endl;
-				return EXIT_FAILURE;
-			}
+			ParsedVector2 v = InstrumentedParseVector2(lines[n]);
+			if (v.error == ParseError::None)
+				keys[n] = TextCanonicalKey;
+			error = v.error;
+			offset = v.errorOffset;
+			length = v.errorLength;
 		}
-		else if (j.rfind("E:", 0) == 0) // Exploit Code Maturity (E)
+		else
 		{
-			string exploitMaturity = GetValue(j);
-			if (exploitMaturity.compare("X") == 0)
-			{
-				e = ExploitCodeMaturity::NotDefined;
-				continue;
-			}
-			else if (exploitMaturity.compare("U") == 0)
-			{
-				e = ExploitCodeMaturity::Unproven;
-				continue;
-			}
-			else if (exploitMaturity.compare("P") == 0)
-			{
-				e = ExploitCodeMaturity::ProofOfConcept;
-				continue;
-			}
-			else if (exploitMaturity.compare("F") == 0)
-			{
-				e = ExploitCodeMaturity::Functional;
-				continue;
-			}
-			else if (exploitMaturity.compare("H") == 0)
-			{
-				e = ExploitCodeMaturity::High;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Exploit Code Maturity: " << exploitMaturity << endl;
-				return EXIT_FAILURE;
-			}
+			ParsedVector4 v = InstrumentedParseVector4(lines[n]);
+			if (v.error == ParseError::None)
+				keys[n] = TextCanonicalKey;
+			error = v.error;
+			offset = v.errorOffset;
+			length = v.errorLength;
 		}
-		else if (j.rfind("RL:", 0) == 0) // Remediation Level (RL)
+
+		if (error != ParseError::None)
 		{
-			string remediationLevel = GetValue(j);
-			if (remediationLevel.compare("X") == 0)
-			{
-				rl = RemediationLevel::NotDefined;
-				continue;
-			}
-			else if (remediationLevel.compare("O") == 0)
-			{
-				rl = RemediationLevel::OfficialFix;
-				continue;
-			}
-			else if (remediationLevel.compare("T") == 0)
-			{
-				rl = RemediationLevel::TemporaryFix;
-				continue;
-			}
-			else if (remediationLevel.compare("W") == 0)
-			{
-				rl = RemediationLevel::Workaround;
-				continue;
-			}
-			else if (remediationLevel.compare("U") == 0)
-			{
-				rl = RemediationLevel::Unavailable;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Remediation Level: " << remediationLevel << endl;
-				return EXIT_FAILURE;
-			}
+			ret = false;
+			if (!suppressErrors)
+				errors += "Line " + to_string(firstLine + n) + ": " + GetErrorMessage(lines[n], error, offset, length) + '\n';
 		}
-		else if (j.rfind("RC:", 0) == 0) // Report Confidence (RC)
-		{
-			string reportConfidence = GetValue(j);
-			if (reportConfidence.compare("X") == 0)
-			{
-				rc = ReportConfidence::NotDefined;
-				continue;
-			}
-			else if (reportConfidence.compare("U") == 0)
-			{
-				rc = ReportConfidence::Unknown;
-				continue;
-			}
-			else if (reportConfidence.compare("R") == 0)
-			{
-				rc = ReportConfidence::Reasonable;
-				continue;
-			}
-			else if (reportConfidence.compare("C") == 0)
-			{
-				rc = ReportConfidence::Confirmed;
-				continue;
-			}
+	}
+	return ret;
+}
+
+//chunks of a batch become the blocks of binary output
+static_assert(BatchChunkSize == BinaryBlockRecords, "binary blocks are written one batch chunk at a time");
+
+//one block of batch lines along with the per-chunk buffers they are formatted into
+struct BatchBlock
+{
+	vector<string_view> lines;
+	vector<string> outputs;
+	vector<string> errors;
+	vector<char> chunkOk;
+	vector<ScoreSummary> summaries;
+	vector<uint64_t> keys;
+
+	//score the block's chunks on the pool, then write them back in input order; with a summary, the chunks
+	//are added to it instead of written, and with distinct vectors, they are keyed in parallel and numbered
+	//in input order, writing each line's number to the index
+	bool Write(size_t firstLine, ThreadPool &pool, ScoreCache *cache, EnvironmentalProfile const *profile, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, bool binary, ScoreSummary *summary, DistinctVectors *distinct, ostream *index)
+	{
+		size_t chunks = (lines.size() + BatchChunkSize - 1) / BatchChunkSize;
+		outputs.resize(chunks);
+		errors.resize(chunks);
+		chunkOk.assign(chunks, 1);
+		if (summary)
+			summaries.assign(chunks, ScoreSummary());
+		if (distinct)
+			keys.resize(lines.size());
+		pool.Run(chunks, [&](size_t chunk) {
+			size_t first = chunk * BatchChunkSize;
+			outputs[chunk].clear();
+			errors[chunk].clear();
+			size_t count = min(lines.size() - first, BatchChunkSize);
+			if (distinct)
+				chunkOk[chunk] = CanonicalizeLines(lines.data() + first, count, firstLine + first, suppressErrors, keys.data() + first, errors[chunk]);
+			else if (summary)
+				chunkOk[chunk] = SummarizeLines(lines.data() + first, count, firstLine + first, suppressErrors, profile, summaries[chunk], errors[chunk]);
+			else if (binary)
+				chunkOk[chunk] = FormatBinaryBatch(lines.data() + first, count, firstLine + first, suppressErrors, profile, outputs[chunk], errors[chunk]);
 			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Report Confidence: " << reportConfidence << endl;
-				return EXIT_FAILURE;
-			}
-		}
-		else if (j.rfind("CR:", 0) == 0) // Confidentiality Requirement (CR)
+				chunkOk[chunk] = FormatBatch(lines.data() + first, count, firstLine + first, baseScore, temporalScore, environmentalScore, suppressErrors, cache, profile, outputs[chunk], errors[chunk]);
+		});
+
+		bool ret = true;
+		CVSS_STAGE_TIMER(Stage::Write);
+		for (size_t chunk = 0; chunk < chunks; chunk++)
 		{
-			string confidentialityRequirement = GetValue(j);
-			if (confidentialityRequirement.compare("X") == 0)
-			{
-				cr = Requirement::NotDefined;
-				continue;
-			}
-			if (confidentialityRequirement.compare("H") == 0)
-			{
-				cr = Requirement::High;
-				continue;
-			}
-			else if (confidentialityRequirement.compare("M") == 0)
-			{
-				cr = Requirement::Medium;
-				continue;
-			}
-			else if (confidentialityRequirement.compare("L") == 0)
-			{
-				cr = Requirement::Low;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Confidentiality Requirement: " << confidentialityRequirement << endl;
-				return EXIT_FAILURE;
-			}
+			out.write(outputs[chunk].data(), outputs[chunk].size());
+			err.write(errors[chunk].data(), errors[chunk].size());
+			if (!chunkOk[chunk])
+				ret = false;
+			if (summary)
+				summary->Merge(summaries[chunk]);
 		}
-		else if (j.rfind("IR:", 0) == 0) // Integrity Requirement (IR)
+
+		if (distinct)
 		{
-			string integrityRequirement = GetValue(j);
-			if (integrityRequirement.compare("X") == 0)
-			{
-				ir = Requirement::NotDefined;
-				continue;
-			}
-			if (integrityRequirement.compare("H") == 0)
-			{
-				ir = Requirement::High;
-				continue;
-			}
-			else if (integrityRequirement.compare("M") == 0)
-			{
-				ir = Requirement::Medium;
-				continue;
-			}
-			else if (integrityRequirement.compare("L") == 0)
-			{
-				ir = Requirement::Low;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Integrity Requirement: " << integrityRequirement << endl;
-				return EXIT_FAILURE;
-			}
+			string numbers;
+			for (size_t n = 0; n < lines.size(); n++)
+			{
+				if (keys[n] != NoCanonicalKey)
+				{
+					size_t id = (keys[n] == TextCanonicalKey) ? distinct->Add(lines[n]) : distinct->Add(PackedVector(keys[n]));
+					numbers += to_string(id + 1); //the line of the distinct vector in the output
+				}
+				numbers.push_back('\n');
+			}
+			if (index)
+				index->write(numbers.data(), numbers.size());
 		}
-		else if (j.rfind("AR:", 0) == 0) // Availability Requirement (AR)
+		return ret;
+	}
+};
+
+//the body of both ParseBatch() overloads; nextBlock(lines, maxLines) replaces lines with the next block of
+//input lines and returns false once there are none, so every input is scored by the same code
+template<typename NextBlock> static int ParseBlocks(NextBlock nextBlock, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, unsigned threads, size_t cacheSize, EnvironmentalProfile const *profile, bool binary, bool summary, bool distinct, ostream *index)
+{
+	ThreadPool pool(threads);
+	unique_ptr<ScoreCache> cache((cacheSize && !binary && !summary && !distinct) ? new ScoreCache(cacheSize, 0, profile) : nullptr); //binary records, summaries and distinct vectors need the parsed vector, which the cache does not keep
+	const size_t blockLines = BatchChunkSize * 4 * pool.GetThreads();
+	int ret = EXIT_SUCCESS;
+	size_t lineNumber = 1;
+	BatchBlock block;
+
+	if (!baseScore && !temporalScore && !environmentalScore)
+		baseScore = true;
+	ScoreSummary total;
+	DistinctVectors distinctVectors;
+	if (binary && !summary && !distinct)
+	{
+		string header;
+		AppendBinaryHeader(header);
+		out.write(header.data(), header.size());
+	}
+
+	while (true)
+	{
 		{
-			string availabilityRequirement = GetValue(j);
-			if (availabilityRequirement.compare("X") == 0)
-			{
-				ar = Requirement::NotDefined;
-				continue;
-			}
-			if (availabilityRequirement.compare("H") == 0)
-			{
-				ar = Requirement::High;
-				continue;
-			}
-			else if (availabilityRequirement.compare("M") == 0)
-			{
-				ar = Requirement::Medium;
-				continue;
-			}
-			else if (availabilityRequirement.compare("L") == 0)
-			{
-				ar = Requirement::Low;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Availability Requirement: " << availabilityRequirement << endl;
-				return EXIT_FAILURE;
-			}
+			CVSS_STAGE_TIMER(Stage::Read);
+			block.lines.clear();
+			if (!nextBlock(block.lines, blockLines))
+				break;
 		}
-		else if (j.rfind("MAV:", 0) == 0) // Modified Attack Vector (MAV)
+
+		if (!block.Write(lineNumber, pool, cache.get(), profile, out, err, baseScore, temporalScore, environmentalScore, suppressErrors, binary, summary ? &total : nullptr, distinct ? &distinctVectors : nullptr, index))
+			ret = EXIT_FAILURE;
+		lineNumber += block.lines.size();
+	}
+	if (distinct)
+	{
+		//one line per distinct vector, in the order first seen, as uniq -c writes them
+		string report;
+		for (size_t id = 0; id < distinctVectors.GetCount(); id++)
+			report += to_string(distinctVectors.GetOccurrences(id)) + '\t' + distinctVectors.GetVector(id) + '\n';
+		out.write(report.data(), report.size());
+	}
+	else if (summary)
+	{
+		string report = FormatSummary(total, baseScore, temporalScore, environmentalScore);
+		out.write(report.data(), report.size());
+	}
+	out.flush();
+	err.flush();
+	if (index)
+		index->flush();
+
+	return ret;
+}
+
+int ParseBatch(istream &in, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, unsigned threads, size_t cacheSize, EnvironmentalProfile const *profile, bool binary, bool summary, bool distinct, ostream *index)
+{
+	string line;
+	string text;
+	vector<size_t> ends;
+
+	//streams are copied into a block of lines before scoring
+	return ParseBlocks([&](vector<string_view> &lines, size_t maxLines) {
+		text.clear();
+		ends.clear();
+		while ((ends.size() < maxLines) && getline(in, line))
 		{
-			mav.modified = true;
-			string attackVector = GetValue(j);
-			if (attackVector.compare("X"))
-			{
-				mav.modified = false;
-				continue;
-			}
-			else if (attackVector.compare("N") == 0)
-			{
-				mav.parent = AttackVector::Network;
-				continue;
-			}
-			else if (attackVector.compare("A") == 0)
-			{
-				mav.parent = AttackVector::Adjacent;
-				continue;
-			}
-			else if (attackVector.compare("P") == 0)
-			{
-				mav.parent = AttackVector::Physical;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Attack Vector: " << attackVector << endl;
-				return EXIT_FAILURE;
-			}
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			text.append(line);
+			ends.push_back(text.size());
 		}
-		else if (j.rfind("MAC:", 0) == 0) // Modified Attack Complexity (MAC)
+
+		size_t start = 0;
+		for (size_t end : ends)
 		{
-			mac.modified = true;
-			string attackComplexity = GetValue(j);
-			if (attackComplexity.compare("X") == 0)
-			{
-				mac.modified = false;
-				continue;
-			}
-			else if (attackComplexity.compare("L") == 0)
-			{
-				mac.parent = AttackComplexity::Low;
-				continue;
-			}
-			else if (attackComplexity.compare("H") == 0)
-			{
-				mac.parent = AttackComplexity::High;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Attack Complexity: " << attackComplexity << endl;
-				return EXIT_FAILURE;
-			}
+			lines.emplace_back(text.data() + start, end - start);
+			start = end;
 		}
-		else if (j.rfind("MPR:", 0) == 0) // Modified Privileges Required (MPR)
+		return !lines.empty();
+	}, out, err, baseScore, temporalScore, environmentalScore, suppressErrors, threads, cacheSize, profile, binary, summary, distinct, index);
+}
+
+int ParseBatch(string_view data, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, unsigned threads, size_t cacheSize, EnvironmentalProfile const *profile, bool binary, bool summary, bool distinct, ostream *index)
+{
+	LineIterator iterator(data);
+	string_view line;
+
+	//lines are views straight into data, so nothing is copied before scoring
+	return ParseBlocks([&](vector<string_view> &lines, size_t maxLines) {
+		while ((lines.size() < maxLines) && iterator.Next(line))
+			lines.push_back(line);
+		return !lines.empty();
+	}, out, err, baseScore, temporalScore, environmentalScore, suppressErrors, threads, cacheSize, profile, binary, summary, distinct, index);
+}
+
+//scores the vectors an NVDScanner finds, buffering output and errors between flushes
+class NVDWriter
+{
+	private:
+		static const size_t FlushSize = 1 << 20;
+
+		ostream &_out;
+		ostream &_err;
+		bool _baseScore;
+		bool _temporalScore;
+		bool _environmentalScore;
+		bool _suppressErrors;
+		ScoreCache *_cache;
+		EnvironmentalProfile const *_profile;
+		string _output;
+		string _errors;
+		bool _ret;
+
+	public:
+		NVDWriter(ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, ScoreCache *cache, EnvironmentalProfile const *profile) :
+			_out(out), _err(err), _baseScore(baseScore || (!temporalScore && !environmentalScore)), _temporalScore(temporalScore), _environmentalScore(environmentalScore), _suppressErrors(suppressErrors), _cache(cache), _profile(profile), _ret(true)
 		{
-			mpr.modified = true;
-			string privilegesRequired = GetValue(j);
-			if (privilegesRequired.compare("X") == 0)
-			{
-				mpr.modified = false;
-				continue;
-			}
-			if (privilegesRequired.compare("N") == 0)
-			{
-				mpr.parent = PrivilegesRequired::None;
-				continue;
-			}
-			else if (privilegesRequired.compare("L") == 0)
-			{
-				mpr.parent = PrivilegesRequired::Low;
-				continue;
-			}
-			else if (privilegesRequired.compare("H") == 0)
-			{
-				mpr.parent = PrivilegesRequired::High;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Privileges Required: " << privilegesRequired << endl;
-				return EXIT_FAILURE;
-			}
+			_output.reserve(FlushSize + 1024);
 		}
-		else if (j.rfind("MUI:", 0) == 0) // Modified User Interaction (MUI)
+
+		void Add(string_view id, string_view vector)
 		{
-			mui.modified = true;
-			string userInteraction = GetValue(j);
-			if (userInteraction.compare("X") == 0)
+			ScoreResult result = _cache ? _cache->Score(vector) : (_profile ? _profile->Score(vector) : Score(vector));
+			if (result.error != ParseError::None)
 			{
-				mui.modified = false;
-				continue;
+				_ret = false;
+				if (!_suppressErrors)
+				{
+					_errors.append(id.empty() ? string_view("(no CVE ID)") : id);
+					_errors += ": " + GetErrorMessage(vector, result.error, result.errorOffset, result.errorLength) + '\n';
+				}
+				return;
 			}
-			else if (userInteraction.compare("N") == 0)
+
+			CVSS_STAGE_TIMER(Stage::Format);
+			_output.append(id);
+			_output.push_back('\t');
+			_output.append(vector);
+			if (_baseScore)
 			{
-				mui.parent = UserInteraction::None;
-				continue;
+				_output.push_back('\t');
+				AppendScore(_output, result.base);
 			}
-			else if (userInteraction.compare("R") == 0)
+			if (_temporalScore)
 			{
-				mui.parent = UserInteraction::Required;
-				continue;
+				_output.push_back('\t');
+				AppendScore(_output, result.temporal);
 			}
-			else
+			if (_environmentalScore)
 			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified User Interaction: " << userInteraction << endl;
-				return EXIT_FAILURE;
+				_output.push_back('\t');
+				AppendScore(_output, result.environmental);
 			}
+			_output.push_back('\n');
+			if (_output.size() >= FlushSize)
+				Flush();
 		}
-		else if (j.rfind("MS:", 0) == 0) // Modified Scope (MS)
+
+		bool Flush()
 		{
-			ms.modified = true;
-			string scope = GetValue(j);
-			if (scope.compare("X") == 0)
-			{
-				ms.modified = false;
-				continue;
-			}
-			else if (scope.compare("U") == 0)
-			{
-				ms.parent = Scope::Unchanged;
-				continue;
-			}
-			else if (scope.compare("C") == 0)
-			{
-				ms.parent = Scope::Changed;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Scope: " << scope << endl;
-				return EXIT_FAILURE;
-			}
+			CVSS_STAGE_TIMER(Stage::Write);
+			_out.write(_output.data(), _output.size());
+			_err.write(_errors.data(), _errors.size());
+			_output.clear();
+			_errors.clear();
+			return _ret;
 		}
-		else if (j.rfind("MC:", 0) == 0) // Modified Confidentiality (MC)
+};
+
+int ParseNVD(istream &in, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, size_t cacheSize, EnvironmentalProfile const *profile)
+{
+	unique_ptr<ScoreCache> cache(cacheSize ? new ScoreCache(cacheSize, 0, profile) : nullptr);
+	NVDWriter writer(out, err, baseScore, temporalScore, environmentalScore, suppressErrors, cache.get(), profile);
+	NVDScanner scanner([&writer](string_view id, string_view vector) { writer.Add(id, vector); });
+
+	//the scanner carries its state across blocks, so only one block is ever held
+	vector<char> block(1 << 20);
+	while (in)
+	{
 		{
-			mc.modified = true;
-			string confidentiality = GetValue(j);
-			if (confidentiality.compare("X") == 0)
-			{
-				mc.modified = false;
-				continue;
-			}
-			else if (confidentiality.compare("H") == 0)
-			{
-				mc.parent = Impact::High;
-				continue;
-			}
-			else if (confidentiality.compare("L") == 0)
-			{
-				mc.parent = Impact::Low;
-				continue;
-			}
-			else if (confidentiality.compare("N") == 0)
-			{
-				mc.parent = Impact::None;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Confidentiality: " << confidentiality << endl;
-				return EXIT_FAILURE;
-			}
+			CVSS_STAGE_TIMER(Stage::Read);
+			in.read(block.data(), block.size());
 		}
-		else if (j.rfind("MI:", 0) == 0) // Modified Integrity (MI)
+		scanner.Feed(string_view(block.data(), static_cast<size_t>(in.gcount())));
+	}
+	int ret = writer.Flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+	out.flush();
+	err.flush();
+	return ret;
+}
+
+int ParseNVD(string_view data, ostream &out, ostream &err, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, size_t cacheSize, EnvironmentalProfile const *profile)
+{
+	unique_ptr<ScoreCache> cache(cacheSize ? new ScoreCache(cacheSize, 0, profile) : nullptr);
+	NVDWriter writer(out, err, baseScore, temporalScore, environmentalScore, suppressErrors, cache.get(), profile);
+	NVDScanner scanner([&writer](string_view id, string_view vector) { writer.Add(id, vector); });
+
+	scanner.Feed(data);
+	int ret = writer.Flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+	out.flush();
+	err.flush();
+	return ret;
+}
+
+//copies CSV or TSV rows through with score and severity columns appended, buffering output and errors between flushes
+class CSVWriter
+{
+	private:
+		static const size_t FlushSize = 1 << 20;
+
+		ostream &_out;
+		ostream &_err;
+		char _delimiter;
+		size_t _column;
+		bool _header; //the next non-blank row names the columns
+		bool _baseScore;
+		bool _temporalScore;
+		bool _environmentalScore;
+		bool _suppressErrors;
+		ScoreCache *_cache;
+		EnvironmentalProfile const *_profile;
+		size_t _rowNumber;
+		string _output;
+		string _errors;
+		bool _ret;
+
+	public:
+		CSVWriter(ostream &out, ostream &err, char delimiter, size_t column, bool header, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, ScoreCache *cache, EnvironmentalProfile const *profile) :
+			_out(out), _err(err), _delimiter(delimiter), _column(column), _header(header), _baseScore(baseScore || (!temporalScore && !environmentalScore)), _temporalScore(temporalScore), _environmentalScore(environmentalScore), _suppressErrors(suppressErrors), _cache(cache), _profile(profile), _rowNumber(0), _ret(true)
 		{
-			mi.modified = true;
-			string integrity = GetValue(j);
-			if (integrity.compare("X") == 0)
-			{
-				mi.modified = false;
-				continue;
-			}
-			else if (integrity.compare("H") == 0)
-			{
-				mi.parent = Impact::High;
-				continue;
-			}
-			else if (integrity.compare("L") == 0)
-			{
-				mi.parent = Impact::Low;
-				continue;
-			}
-			else if (integrity.compare("N") == 0)
-			{
-				mi.parent = Impact::None;
-				continue;
-			}
-			else
-			{
-				if (!suppressErrors)
-					cerr << "Unknown Modified Integrity: " << integrity << endl;
-				return EXIT_FAILURE;
-			}
+			_output.reserve(FlushSize + 1024);
 		}
-		else if (j.rfind("MA:", 0) == 0) // Modified Availability (MA)
+
+		void Add(string_view row, string_view ending, string_view field, bool hasField)
 		{
-			ma.modified = true;
-			string availability = GetValue(j);
-			if (availability.compare("X") == 0)
+			_rowNumber++;
+			_output.append(row);
+			if (row.empty())
 			{
-				ma.modified = false;
-				continue;
+				//blank rows are copied through as they are
+				_output.append(ending);
+				return;
 			}
-			else if (availability.compare("H") == 0)
-			{
-				ma.parent = Impact::High;
-				continue;
-			}
-			else if (availability.compare("L") == 0)
-			{
-				ma.parent = Impact::Low;
-				continue;
-			}
-			else if (availability.compare("N") == 0)
+
+			if (_header)
 			{
-				ma.parent = Impact::None;
-				continue;
+				_header = false;
+				if (_baseScore)
+					_output.append(1, _delimiter).append("Base");
+				if (_temporalScore)
+					_output.append(1, _delimiter).append("Temporal");
+				if (_environmentalScore)
+					_output.append(1, _delimiter).append("Environmental");
+				_output.append(1, _delimiter).append("Severity");
 			}
 			else
 			{
-				if (!suppressErrors)
-					cerr << "Unknown Availability: " << availability << endl;
-				return EXIT_FAILURE;
-			}
+				ScoreResult result;
+				bool scored = hasField && !field.empty();
+				if (scored)
+				{
+					result = _cache ? _cache->Score(field) : (_profile ? _profile->Score(field) : Score(field));
+					scored = (result.error == ParseError::None);
+				}
+
+				if (scored)
+				{
+					CVSS_STAGE_TIMER(Stage::Format);
+					if (_baseScore)
+					{
+						_output.push_back(_delimiter);
+						AppendScore(_output, result.base);
+					}
+					if (_temporalScore)
+					{
+						_output.push_back(_delimiter);
+						AppendScore(_output, result.temporal);
+					}
+					if (_environmentalScore)
+					{
+						_output.push_back(_delimiter);
+						AppendScore(_output, result.environmental);
+					}
+					_output.push_back(_delimiter);
+					_output.append(SeverityString(GetSeverity(result.base)));
+				}
+				else
+				{
+					//unscored rows keep their shape with empty columns
+					_output.append((_baseScore ? 1 : 0) + (_temporalScore ? 1 : 0) + (_environmentalScore ? 1 : 0) + 1, _delimiter);
+					if (!hasField)
+					{
+						_ret = false;
+						if (!_suppressErrors)
+							_errors += "Row " + to_string(_rowNumber) + ": no column " + to_string(_column + 1) + '\n';
+					}
+					else if (!field.empty())
+					{
+						_ret = false;
+						if (!_suppressErrors)
+							_errors += "Row " + to_string(_rowNumber) + ": " + GetErrorMessage(field, result.error, result.errorOffset, result.errorLength) + '\n';
+					}
+				}
+			}
+			_output.append(ending);
+			if (_output.size() >= FlushSize)
+				Flush();
 		}
-		else
+
+		bool Flush()
 		{
-			if (!suppressErrors)
-				cerr << "Unknown component: " << j << endl;
-			return EXIT_FAILURE;
+			CVSS_STAGE_TIMER(Stage::Write);
+			_out.write(_output.data(), _output.size());
+			_err.write(_errors.data(), _errors.size());
+			_output.clear();
+			_errors.clear();
+			return _ret;
 		}
-	}
-
-	CVSS *cvss = nullptr;
-	if (tmpCvssVersion.compare("3.0") == 0)
-	{
-		cvss = new CVSS_3(av, ac, pr, ui, s, c, i, a, e, rl, rc, cr, ir, ar, mav, mac, mpr, mui, ms, mc, mi, ma);
-	}
-	else if (tmpCvssVersion.compare("3.1") == 0)
-	{
-		cvss = new CVSS_3_1(av, ac, pr, ui, s, c, i, a, e, rl, rc, cr, ir, ar, mav, mac, mpr, mui, ms, mc, mi, ma);
-	}
-
-	if (!cvss)
-	{
-		return EXIT_FAILURE;
-	}
-
-	if (!baseScore && !temporalScore && !environmentalScore)
-		baseScore = true;
-	
-	if (baseScore)
-	{
-		if (temporalScore || environmentalScore)
-			cout << "Base: ";
-		cout << cvss->GetBaseScore() << endl;
-	}
+};
 
-	if (temporalScore)
-	{
-		if (baseScore || environmentalScore)
-			cout << "Temporal: ";
-		cout << cvss->GetTemporalScore() << endl;
-	}
+int ParseCSV(istream &in, ostream &out, ostream &err, size_t column, char delimiter, bool header, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, size_t cacheSize, EnvironmentalProfile const *profile)
+{
+	unique_ptr<ScoreCache> cache(cacheSize ? new ScoreCache(cacheSize, 0, profile) : nullptr);
+	CSVWriter writer(out, err, delimiter, column, header, baseScore, temporalScore, environmentalScore, suppressErrors, cache.get(), profile);
+	string text;
+	vector<char> block(1 << 20);
+	string_view row, ending, field;
+	bool hasField;
 
-	if (environmentalScore)
+	//rows are taken from the front of the buffer; a row cut off by the end of a block waits for the next one
+	bool final = false;
+	while (!final)
 	{
-		if (baseScore || temporalScore)
-			cout << "Environmental: ";
-		cout << cvss->GetEnvironmentalScore() << endl;
+		{
+			CVSS_STAGE_TIMER(Stage::Read);
+			in.read(block.data(), block.size());
+			text.append(block.data(), static_cast<size_t>(in.gcount()));
+			final = !in;
+		}
+		CSVIterator rows(text, delimiter, column, final);
+		while (rows.Next(row, ending, field, hasField))
+			writer.Add(row, ending, field, hasField);
+		text.erase(0, rows.GetPosition());
 	}
+	int ret = writer.Flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+	out.flush();
+	err.flush();
+	return ret;
+}
 
-	delete cvss;
+int ParseCSV(string_view data, ostream &out, ostream &err, size_t column, char delimiter, bool header, bool baseScore, bool temporalScore, bool environmentalScore, bool suppressErrors, size_t cacheSize, EnvironmentalProfile const *profile)
+{
+	unique_ptr<ScoreCache> cache(cacheSize ? new ScoreCache(cacheSize, 0, profile) : nullptr);
+	CSVWriter writer(out, err, delimiter, column, header, baseScore, temporalScore, environmentalScore, suppressErrors, cache.get(), profile);
+	CSVIterator rows(data, delimiter, column);
+	string_view row, ending, field;
+	bool hasField;
 
-	return EXIT_SUCCESS;
+	while (rows.Next(row, ending, field, hasField))
+		writer.Add(row, ending, field, hasField);
+	int ret = writer.Flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+	out.flush();
+	err.flush();
+	return ret;
 }
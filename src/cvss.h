@@ -20,7 +20,12 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef HAVE_CVSS_H_
 #define HAVE_CVSS_H_
 
+#include <cstddef>
+#include <iosfwd>
 #include <string>
+#include <string_view>
+
+class EnvironmentalProfile;
 
 class CVSS
 {
@@ -31,6 +36,12 @@ class CVSS
 		virtual float GetEnvironmentalScore(bool round = true) {return 0;}; //Environmental Score
 };
 
-int Parse(std::string const& data, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false);
+int Parse(std::string const& data, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, EnvironmentalProfile const *profile = nullptr); //a profile is overlaid on the vector before scoring
+int ParseBatch(std::istream &in, std::ostream &out, std::ostream &err, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, unsigned threads = 1, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr, bool binary = false, bool summary = false, bool distinct = false, std::ostream *index = nullptr); //one vector per input line, one score line per vector; 0 threads uses every hardware thread, a cacheSize memoises at most that many distinct vectors (not used with binary, summary or distinct, which need each parsed vector), binary writes cvss_binary.h records instead of text, summary writes only FormatSummary() of the selected scores, distinct writes each distinct vector once with its count and, to index, the output line of each input line's vector
+int ParseBatch(std::string_view data, std::ostream &out, std::ostream &err, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, unsigned threads = 1, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr, bool binary = false, bool summary = false, bool distinct = false, std::ostream *index = nullptr); //same, over newline-delimited vectors already in memory (e.g. a MappedFile)
+int ParseNVD(std::istream &in, std::ostream &out, std::ostream &err, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr); //an NVD CVE JSON feed, streamed without building a document; writes "CVE-ID\tvector\tscores" for each vectorString, in feed order
+int ParseNVD(std::string_view data, std::ostream &out, std::ostream &err, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr); //same, over a feed already in memory (e.g. a MappedFile)
+int ParseCSV(std::istream &in, std::ostream &out, std::ostream &err, size_t column, char delimiter = ',', bool header = false, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr); //copies each CSV (or, with '\t', TSV) row through in one pass, appending the selected scores and the base severity of the vector in the 0-based column; a header row (the first that is not blank) gets column names instead
+int ParseCSV(std::string_view data, std::ostream &out, std::ostream &err, size_t column, char delimiter = ',', bool header = false, bool baseScore = false, bool temporalScore = false, bool environmentalScore = false, bool suppressErrors = false, size_t cacheSize = 0, EnvironmentalProfile const *profile = nullptr); //same, over rows already in memory (e.g. a MappedFile)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_2.h"
+#include "cvss_2_engine.h"
+
+using namespace std;
+
+CVSS_2::CVSS_2(Vector2Metrics const& metrics) :
+	_metrics(metrics)
+{
+}
+
+float CVSS_2::GetImpact(bool adjusted)
+{
+	return static_cast<float>(CVSS_2_Engine(_metrics).GetImpact(adjusted));
+}
+
+float CVSS_2::GetExploitability()
+{
+	return static_cast<float>(CVSS_2_Engine(_metrics).GetExploitability());
+}
+
+float CVSS_2::GetBaseScore(bool modified, bool round)
+{
+	return CVSS_2_Engine(_metrics).GetBaseScore(modified, round);
+}
+
+float CVSS_2::GetTemporalScore(bool round)
+{
+	return CVSS_2_Engine(_metrics).GetTemporalScore(round);
+}
+
+float CVSS_2::GetEnvironmentalScore(bool round)
+{
+	return CVSS_2_Engine(_metrics).GetEnvironmentalScore(round);
+}
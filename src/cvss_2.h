@@ -0,0 +1,129 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_2_H_
+#define HAVE_CVSS_2_H_
+
+#include "cvss_3_1.h"
+
+//2.0 reuses the 3.x Requirement values
+enum class AccessVector {
+	Local,
+	AdjacentNetwork,
+	Network
+};
+
+enum class AccessComplexity {
+	High,
+	Medium,
+	Low
+};
+
+enum class Authentication {
+	Multiple,
+	Single,
+	None
+};
+
+enum class Impact2 {
+	None,
+	Partial,
+	Complete
+};
+
+enum class Exploitability {
+	NotDefined,
+	Unproven,
+	ProofOfConcept,
+	Functional,
+	High
+};
+
+enum class RemediationLevel2 {
+	NotDefined,
+	OfficialFix,
+	TemporaryFix,
+	Workaround,
+	Unavailable
+};
+
+enum class ReportConfidence2 {
+	NotDefined,
+	Unconfirmed,
+	Uncorroborated,
+	Confirmed
+};
+
+enum class CollateralDamagePotential {
+	NotDefined,
+	None,
+	Low,
+	LowMedium,
+	MediumHigh,
+	High
+};
+
+enum class TargetDistribution {
+	NotDefined,
+	None,
+	Low,
+	Medium,
+	High
+};
+
+//metrics of a 2.0 vector; ParseVector2() fills them in, and unspecified base metrics default to their most
+//severe value, as in 3.x
+struct Vector2Metrics
+{
+	//Base Metrics
+	AccessVector av = AccessVector::Network; //Access Vector
+	AccessComplexity ac = AccessComplexity::Low; //Access Complexity
+	Authentication au = Authentication::None; //Authentication
+	Impact2 c = Impact2::Complete; //Confidentiality Impact
+	Impact2 i = Impact2::Complete; //Integrity Impact
+	Impact2 a = Impact2::Complete; //Availability Impact
+
+	//Temporal Metrics
+	Exploitability e = Exploitability::NotDefined; //Exploitability
+	RemediationLevel2 rl = RemediationLevel2::NotDefined; //Remediation Level
+	ReportConfidence2 rc = ReportConfidence2::NotDefined; //Report Confidence
+
+	//Environmental Metrics
+	CollateralDamagePotential cdp = CollateralDamagePotential::NotDefined; //Collateral Damage Potential
+	TargetDistribution td = TargetDistribution::NotDefined; //Target Distribution
+	Requirement cr = Requirement::NotDefined; //Confidentiality Requirement
+	Requirement ir = Requirement::NotDefined; //Integrity Requirement
+	Requirement ar = Requirement::NotDefined; //Availability Requirement
+};
+
+class CVSS_2 : public CVSS
+{
+	private:
+		Vector2Metrics _metrics;
+
+	public:
+		explicit CVSS_2(Vector2Metrics const& metrics);
+		float GetImpact(bool adjusted = false); //Impact, or AdjustedImpact with the security requirements
+		float GetExploitability();
+		float GetBaseScore(bool modified = false, bool round = true) override; //Base Score, or AdjustedBase when modified
+		float GetTemporalScore(bool round = true) override; //Temporal Score
+		float GetEnvironmentalScore(bool round = true) override; //Environmental Score
+};
+
+#endif
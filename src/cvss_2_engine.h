@@ -0,0 +1,302 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_2_ENGINE_H_
+#define HAVE_CVSS_2_ENGINE_H_
+
+#include "cvss_score.h"
+#include "cvss_vector.h"
+
+#include <algorithm>
+
+//non-virtual, header-only CVSS 2.0 scorer; CVSS_2 uses it, and everything is constexpr, so 2.0 vectors known at
+//build time can be scored by the compiler
+class CVSS_2_Engine
+{
+	private:
+		Vector2Metrics _v;
+
+	public:
+	//formulas, shared with the 2.0 score tables
+		//round_to_1_decimal of the specification; the nudge keeps exact halves such as 9.15 from rounding down
+		//when binary arithmetic lands just below them
+		static constexpr double Round(double x)
+		{
+			return static_cast<double>(static_cast<long>(x * 10.0 + 0.5 + 1e-9)) / 10.0;
+		}
+		static constexpr double BaseScore(double impact, double exploitability); //unrounded
+		static constexpr double TemporalWeight(Exploitability e, RemediationLevel2 rl, ReportConfidence2 rc); //E x RL x RC
+		static constexpr double EnvironmentalScore(double adjustedTemporal, CollateralDamagePotential cdp, TargetDistribution td); //unrounded
+
+	//weights
+		static constexpr double AccessVectorWeight(AccessVector av);
+		static constexpr double AccessComplexityWeight(AccessComplexity ac);
+		static constexpr double AuthenticationWeight(Authentication au);
+		static constexpr double ImpactWeight(Impact2 impact);
+		static constexpr double ExploitabilityWeight(Exploitability e);
+		static constexpr double RemediationLevelWeight(RemediationLevel2 rl);
+		static constexpr double ReportConfidenceWeight(ReportConfidence2 rc);
+		static constexpr double CollateralDamagePotentialWeight(CollateralDamagePotential cdp);
+		static constexpr double TargetDistributionWeight(TargetDistribution td);
+		static constexpr double RequirementWeight(Requirement r);
+
+		constexpr explicit CVSS_2_Engine(Vector2Metrics const& v) : _v(v) {}
+		constexpr void Reset(Vector2Metrics const& v) { _v = v; }
+
+		constexpr double GetImpact(bool adjusted = false) const; //Impact, or AdjustedImpact
+		constexpr double GetExploitability() const;
+		constexpr float GetBaseScore(bool adjusted = false, bool round = true) const; //Base Score, or AdjustedBase
+		constexpr float GetTemporalScore(bool round = true) const;
+		constexpr float GetEnvironmentalScore(bool round = true) const;
+		constexpr void GetScores(ScoreResult &result) const; //all three rounded scores, sharing the work between them
+};
+
+constexpr double CVSS_2_Engine::AccessVectorWeight(AccessVector av)
+{
+	switch (av)
+	{
+	case AccessVector::Local:
+		return 0.395;
+	case AccessVector::AdjacentNetwork:
+		return 0.646;
+	case AccessVector::Network:
+		return 1.0;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::AccessComplexityWeight(AccessComplexity ac)
+{
+	switch (ac)
+	{
+	case AccessComplexity::High:
+		return 0.35;
+	case AccessComplexity::Medium:
+		return 0.61;
+	case AccessComplexity::Low:
+		return 0.71;
+	}
+	return 0.71;
+}
+
+constexpr double CVSS_2_Engine::AuthenticationWeight(Authentication au)
+{
+	switch (au)
+	{
+	case Authentication::Multiple:
+		return 0.45;
+	case Authentication::Single:
+		return 0.56;
+	case Authentication::None:
+		return 0.704;
+	}
+	return 0.704;
+}
+
+constexpr double CVSS_2_Engine::ImpactWeight(Impact2 impact)
+{
+	switch (impact)
+	{
+	case Impact2::None:
+		return 0.0;
+	case Impact2::Partial:
+		return 0.275;
+	case Impact2::Complete:
+		return 0.660;
+	}
+	return 0.660;
+}
+
+constexpr double CVSS_2_Engine::ExploitabilityWeight(Exploitability e)
+{
+	switch (e)
+	{
+	case Exploitability::Unproven:
+		return 0.85;
+	case Exploitability::ProofOfConcept:
+		return 0.9;
+	case Exploitability::Functional:
+		return 0.95;
+	case Exploitability::High:
+	case Exploitability::NotDefined:
+		return 1.0;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::RemediationLevelWeight(RemediationLevel2 rl)
+{
+	switch (rl)
+	{
+	case RemediationLevel2::OfficialFix:
+		return 0.87;
+	case RemediationLevel2::TemporaryFix:
+		return 0.90;
+	case RemediationLevel2::Workaround:
+		return 0.95;
+	case RemediationLevel2::Unavailable:
+	case RemediationLevel2::NotDefined:
+		return 1.0;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::ReportConfidenceWeight(ReportConfidence2 rc)
+{
+	switch (rc)
+	{
+	case ReportConfidence2::Unconfirmed:
+		return 0.90;
+	case ReportConfidence2::Uncorroborated:
+		return 0.95;
+	case ReportConfidence2::Confirmed:
+	case ReportConfidence2::NotDefined:
+		return 1.0;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::CollateralDamagePotentialWeight(CollateralDamagePotential cdp)
+{
+	switch (cdp)
+	{
+	case CollateralDamagePotential::None:
+	case CollateralDamagePotential::NotDefined:
+		return 0.0;
+	case CollateralDamagePotential::Low:
+		return 0.1;
+	case CollateralDamagePotential::LowMedium:
+		return 0.3;
+	case CollateralDamagePotential::MediumHigh:
+		return 0.4;
+	case CollateralDamagePotential::High:
+		return 0.5;
+	}
+	return 0.0;
+}
+
+constexpr double CVSS_2_Engine::TargetDistributionWeight(TargetDistribution td)
+{
+	switch (td)
+	{
+	case TargetDistribution::None:
+		return 0.0;
+	case TargetDistribution::Low:
+		return 0.25;
+	case TargetDistribution::Medium:
+		return 0.75;
+	case TargetDistribution::High:
+	case TargetDistribution::NotDefined:
+		return 1.0;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::RequirementWeight(Requirement r)
+{
+	switch (r)
+	{
+	case Requirement::Low:
+		return 0.5;
+	case Requirement::Medium:
+	case Requirement::NotDefined:
+		return 1.0;
+	case Requirement::High:
+		return 1.51;
+	}
+	return 1.0;
+}
+
+constexpr double CVSS_2_Engine::BaseScore(double impact, double exploitability)
+{
+	//AdjustedImpact with low requirements can take the formula just below 0; scores never go negative
+	double fImpact = (impact == 0) ? 0 : 1.176;
+	return std::max(((0.6 * impact) + (0.4 * exploitability) - 1.5) * fImpact, 0.0);
+}
+
+constexpr double CVSS_2_Engine::TemporalWeight(Exploitability e, RemediationLevel2 rl, ReportConfidence2 rc)
+{
+	return ExploitabilityWeight(e) * RemediationLevelWeight(rl) * ReportConfidenceWeight(rc);
+}
+
+constexpr double CVSS_2_Engine::EnvironmentalScore(double adjustedTemporal, CollateralDamagePotential cdp, TargetDistribution td)
+{
+	return (adjustedTemporal + (10 - adjustedTemporal) * CollateralDamagePotentialWeight(cdp)) * TargetDistributionWeight(td);
+}
+
+constexpr double CVSS_2_Engine::GetImpact(bool adjusted) const
+{
+	double c = ImpactWeight(_v.c) * (adjusted ? RequirementWeight(_v.cr) : 1.0);
+	double i = ImpactWeight(_v.i) * (adjusted ? RequirementWeight(_v.ir) : 1.0);
+	double a = ImpactWeight(_v.a) * (adjusted ? RequirementWeight(_v.ar) : 1.0);
+	return std::min(10.41 * (1 - (1 - c) * (1 - i) * (1 - a)), 10.0);
+}
+
+constexpr double CVSS_2_Engine::GetExploitability() const
+{
+	return 20 * AccessVectorWeight(_v.av) * AccessComplexityWeight(_v.ac) * AuthenticationWeight(_v.au);
+}
+
+constexpr float CVSS_2_Engine::GetBaseScore(bool adjusted, bool round) const
+{
+	double ret = BaseScore(GetImpact(adjusted), GetExploitability());
+	return static_cast<float>(round ? Round(ret) : ret);
+}
+
+constexpr float CVSS_2_Engine::GetTemporalScore(bool round) const
+{
+	double ret = Round(BaseScore(GetImpact(), GetExploitability())) * TemporalWeight(_v.e, _v.rl, _v.rc);
+	return static_cast<float>(round ? Round(ret) : ret);
+}
+
+constexpr float CVSS_2_Engine::GetEnvironmentalScore(bool round) const
+{
+	//the temporal score again, from the base score with AdjustedImpact
+	double adjustedTemporal = Round(Round(BaseScore(GetImpact(true), GetExploitability())) * TemporalWeight(_v.e, _v.rl, _v.rc));
+	double ret = EnvironmentalScore(adjustedTemporal, _v.cdp, _v.td);
+	return static_cast<float>(round ? Round(ret) : ret);
+}
+
+constexpr void CVSS_2_Engine::GetScores(ScoreResult &result) const
+{
+	double exploitability = GetExploitability();
+	double temporalWeight = TemporalWeight(_v.e, _v.rl, _v.rc);
+	double base = Round(BaseScore(GetImpact(), exploitability));
+	double adjustedBase = Round(BaseScore(GetImpact(true), exploitability));
+	result.base = static_cast<float>(base);
+	result.temporal = static_cast<float>(Round(base * temporalWeight));
+	result.environmental = static_cast<float>(Round(EnvironmentalScore(Round(adjustedBase * temporalWeight), _v.cdp, _v.td)));
+}
+
+//score a parsed 2.0 vector; usable in constant expressions
+constexpr ScoreResult ComputeScore(ParsedVector2 const& v)
+{
+	ScoreResult ret;
+	ret.version = CVSSVersion::V2_0;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	CVSS_2_Engine(v).GetScores(ret);
+	return ret;
+}
+
+#endif
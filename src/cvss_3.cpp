@@ -18,8 +18,7 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "cvss_3.h"
-
-#include <cmath>
+#include "cvss_3_engine.h"
 
 CVSS_3::CVSS_3(AttackVector av, AttackComplexity ac, PrivilegesRequired pr, UserInteraction ui, Scope s, Impact c, Impact i, Impact a, ExploitCodeMaturity e, RemediationLevel rl, ReportConfidence rc, Requirement cr, Requirement ir, Requirement ar, Modified<AttackVector> mav, Modified<AttackComplexity> mac, Modified<PrivilegesRequired> mpr, Modified<UserInteraction> mui, Modified<Scope> ms, Modified<Impact> mc, Modified<Impact> mi, Modified<Impact> ma) : CVSS_3_1(av, ac, pr, ui, s, c, i, a, e, rl, rc, cr, ir, ar, mav, mac, mpr, mui, ms, mc, mi, ma)
 {
@@ -27,10 +26,5 @@ CVSS_3::CVSS_3(AttackVector av, AttackComplexity ac, PrivilegesRequired pr, User
 
 float CVSS_3::GetImpact(bool modified)
 {
-	float iss = GetImpactSubScore(modified);
-	if (GetScopeChanged(modified))
-	{
-		return ScoreNormalize(7.52 * (iss - 0.029) - (3.25 * pow(iss - 0.02, 15.0)));
-	}
-	return ScoreNormalize(6.42 * iss);
+	return CVSS_3_Engine<CVSSVersion::V3_0>::ImpactScore(GetImpactSubScore(modified), GetScopeChanged(modified), modified);
 }
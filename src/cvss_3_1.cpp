@@ -18,9 +18,9 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "cvss_3_1.h"
+#include "cvss_3_engine.h"
 
-#include <algorithm>
-#include <cmath>
+typedef CVSS_3_Engine<CVSSVersion::V3_1> Formula;
 
 CVSS_3_1::CVSS_3_1(AttackVector av, AttackComplexity ac, PrivilegesRequired pr, UserInteraction ui, Scope s, Impact c, Impact i, Impact a, ExploitCodeMaturity e, RemediationLevel rl, ReportConfidence rc, Requirement cr, Requirement ir, Requirement ar, Modified<AttackVector> mav, Modified<AttackComplexity> mac, Modified<PrivilegesRequired> mpr, Modified<UserInteraction> mui, Modified<Scope> ms, Modified<Impact> mc, Modified<Impact> mi, Modified<Impact> ma) :
 	_av(av),
@@ -50,56 +50,22 @@ CVSS_3_1::CVSS_3_1(AttackVector av, AttackComplexity ac, PrivilegesRequired pr,
 
 float CVSS_3_1::GetAttackVector(bool modified)
 {
-	switch ((modified && _mav.modified) ? _mav.parent : _av)
-	{
-	case AttackVector::Network:
-		return 0.85;
-	case AttackVector::Adjacent:
-		return 0.62;
-	case AttackVector::Local:
-		return 0.55;
-	case AttackVector::Physical:
-		return 0.2;
-	}
-	return 0;
+	return Formula::AttackVectorWeight((modified && _mav.modified) ? _mav.parent : _av);
 }
 
 float CVSS_3_1::GetAttackComplexity(bool modified)
 {
-	switch ((modified && _mac.modified) ? _mac.parent : _ac)
-	{
-	case AttackComplexity::Low:
-		return 0.77;
-	case AttackComplexity::High:
-		return 0.44;
-	}
-	return 0;
+	return Formula::AttackComplexityWeight((modified && _mac.modified) ? _mac.parent : _ac);
 }
 
 float CVSS_3_1::GetPrivilegesRequired(bool modified)
 {
-	switch ((modified && _mpr.modified) ? _mpr.parent : _pr)
-	{
-	case PrivilegesRequired::None:
-		return 0.85;
-	case PrivilegesRequired::Low:
-		return GetScopeChanged(modified) ? 0.68 : 0.62;
-	case PrivilegesRequired::High:
-		return GetScopeChanged(modified) ? 0.5 : 0.27;
-	}
-	return 0;
+	return Formula::PrivilegesRequiredWeight((modified && _mpr.modified) ? _mpr.parent : _pr, GetScopeChanged(modified));
 }
 
 float CVSS_3_1::GetUserInteraction(bool modified)
 {
-	switch ((modified && _mui.modified) ? _mui.parent : _ui)
-	{
-	case UserInteraction::None:
-		return 0.85;
-	case UserInteraction::Required:
-		return 0.62;
-	}
-	return 0;
+	return Formula::UserInteractionWeight((modified && _mui.modified) ? _mui.parent : _ui);
 }
 
 bool CVSS_3_1::GetScopeChanged(bool modified)
@@ -109,16 +75,7 @@ bool CVSS_3_1::GetScopeChanged(bool modified)
 
 float CVSS_3_1::GetImpact(Impact impact)
 {
-	switch (impact)
-	{
-	case Impact::High:
-		return 0.56;
-	case Impact::Low:
-		return 0.22;
-	case Impact::None:
-		return 0.0;
-	}
-	return 0;
+	return Formula::ImpactWeight(impact);
 }
 
 float CVSS_3_1::GetConfidentiality(bool modified)
@@ -138,17 +95,7 @@ float CVSS_3_1::GetAvailability(bool modified)
 
 float CVSS_3_1::GetRequirement(Requirement r)
 {
-	switch (r)
-	{
-	case (Requirement::High):
-		return 1.5;
-	case (Requirement::Low):
-		return 0.5;
-	case (Requirement::Medium):
-	case (Requirement::NotDefined):
-		return 1.0;
-	}
-	return 1.0; //should never get here; treat impossible values as not defined
+	return Formula::RequirementWeight(r);
 }
 
 float CVSS_3_1::GetConfidentialityRequirement()
@@ -168,111 +115,56 @@ float CVSS_3_1::GetAvailabilityRequirement()
 
 float CVSS_3_1::GetExploitCodeMaturity()
 {
-	switch (_e)
-	{
-	case (ExploitCodeMaturity::Unproven):
-		return 0.91;
-	case (ExploitCodeMaturity::ProofOfConcept):
-		return 0.94;
-	case (ExploitCodeMaturity::Functional):
-		return 0.97;
-	case (ExploitCodeMaturity::High):
-	case (ExploitCodeMaturity::NotDefined):
-		return 1.0;
-	}
-	return 1.0;
+	return Formula::ExploitCodeMaturityWeight(_e);
 }
 
 float CVSS_3_1::GetRemediationLevel()
 {
-	switch (_rl)
-	{
-	case (RemediationLevel::OfficialFix):
-		return 0.95;
-	case (RemediationLevel::TemporaryFix):
-		return 0.96;
-	case (RemediationLevel::Workaround):
-		return 0.97;
-	case (RemediationLevel::Unavailable):
-	case (RemediationLevel::NotDefined):
-		return 1.0;
-	}
-	return 1.0;
+	return Formula::RemediationLevelWeight(_rl);
 }
 
 float CVSS_3_1::GetReportConfidence()
 {
-	switch (_rc)
-	{
-	case (ReportConfidence::Unknown):
-		return 0.92;
-	case (ReportConfidence::Reasonable):
-		return 0.96;
-	case (ReportConfidence::Confirmed):
-	case (ReportConfidence::NotDefined):
-		return 1.0;
-	}
-	return 1.0;
+	return Formula::ReportConfidenceWeight(_rc);
 }
 
 float CVSS_3_1::ScoreNormalize(float score)
 {
-	return std::min(std::max(score, 0.0f), 10.0f);
+	return Formula::ScoreNormalize(score);
 }
 
 float CVSS_3_1::GetImpactSubScore(bool modified)
 {
 	if (modified)
 	{
- 		return std::min((1.0 - ((1.0 - (GetConfidentialityRequirement() * GetConfidentiality(modified))) * (1.0 - (GetIntegrityRequirement() * GetIntegrity(modified))) * (1.0 - (GetAvailabilityRequirement() * GetAvailability(modified))))), 0.915);
+		return Formula::ModifiedImpactSubScore(GetConfidentialityRequirement(), GetConfidentiality(modified), GetIntegrityRequirement(), GetIntegrity(modified), GetAvailabilityRequirement(), GetAvailability(modified));
 	}
-	return (1.0 - ((1.0 - GetConfidentiality(modified)) * (1.0 - GetIntegrity(modified)) * (1.0 - GetAvailability(modified))));
+	return Formula::ImpactSubScore(GetConfidentiality(modified), GetIntegrity(modified), GetAvailability(modified));
 }
 
 float CVSS_3_1::GetImpact(bool modified)
 {
-	float iss = GetImpactSubScore(modified);
-	if (GetScopeChanged(modified))
-	{
-		if (modified)
-		{
-			return ScoreNormalize(7.52 * (iss - 0.029) - (3.25 * pow(iss * 0.9731 - 0.02, 13.0)));
-		}
-		return ScoreNormalize(7.52 * (iss - 0.029) - (3.25 * pow(iss - 0.02, 15.0)));
-	}
-	return ScoreNormalize(6.42 * iss);
+	return Formula::ImpactScore(GetImpactSubScore(modified), GetScopeChanged(modified), modified);
 }
 
 float CVSS_3_1::GetExploitability(bool modified)
 {
-	return ScoreNormalize(8.22 * GetAttackVector(modified) * GetAttackComplexity(modified) * GetPrivilegesRequired(modified) * GetUserInteraction(modified));
+	return Formula::ExploitabilityScore(GetAttackVector(modified), GetAttackComplexity(modified), GetPrivilegesRequired(modified), GetUserInteraction(modified));
 }
 
 float CVSS_3_1::GetBaseScore(bool modified, bool round)
 {
-	float impact = GetImpact(modified);
-	if (impact <= 0.0)
-	{
-		return 0;
-	}
-	float factor = GetScopeChanged(modified) ? 1.08 : 1.0;
-	float tmpBase = ScoreNormalize(factor * (impact + GetExploitability(modified)));
-	if (round)
-		tmpBase = ceil(tmpBase * 10.0) / 10.0;
-	return tmpBase;
+	return Formula::BaseScore(GetImpact(modified), GetExploitability(modified), GetScopeChanged(modified), round);
 }
 
 float CVSS_3_1::GetTemporalScore(bool round)
 {
-	float tmpTemporal = ScoreNormalize(GetBaseScore(false, false) * GetExploitCodeMaturity() * GetRemediationLevel() * GetReportConfidence());
-	if (round)
-		tmpTemporal = ceil (tmpTemporal * 10.0) / 10.0;
-	return tmpTemporal;
+	return Formula::TemporalScore(GetBaseScore(false, false), GetExploitCodeMaturity(), GetRemediationLevel(), GetReportConfidence(), round);
 }
 
 float CVSS_3_1::GetEnvironmentalScore(bool round)
 {
-	return GetBaseScore(true);
+	return GetBaseScore(true, round);
 }
 
 void CVSS_3_1::SetAttackVector(AttackVector av, bool modified)
@@ -155,7 +155,7 @@ class CVSS_3_1 : public CVSS
 		float GetAvailabilityRequirement();
 
 		float GetImpactSubScore(bool modified = false); //ISS
-		float GetImpact(bool modified = false); //Final Impact Score
+		virtual float GetImpact(bool modified = false); //Final Impact Score; 3.0 and 3.1 differ for a changed modified scope
 		float GetExploitability(bool modified = false); //Final Exploitability Score
 		float GetBaseScore(bool modified = false, bool round = true); //Base Score
 		float GetTemporalScore(bool round = true); //Temporal Score
@@ -0,0 +1,369 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_3_ENGINE_H_
+#define HAVE_CVSS_3_ENGINE_H_
+
+#include "cvss_score.h"
+#include "cvss_vector.h"
+
+#include <algorithm>
+
+//non-virtual, header-only CVSS 3.x scorer that can live on the stack and be Reset() for each vector;
+//its static weights and formulas are the ones CVSS_3_1 and CVSS_3 use, so scores are identical, and
+//everything is constexpr so vectors known at build time can be scored by the compiler
+template<CVSSVersion V> class CVSS_3_Engine
+{
+	static_assert((V == CVSSVersion::V3_0) || (V == CVSSVersion::V3_1), "CVSS_3_Engine only scores CVSS 3.x");
+
+	private:
+		ParsedVector _v;
+
+		template<typename T> static constexpr T Pick(T base, Modified<T> const& m, bool modified)
+		{
+			return (modified && m.modified) ? m.parent : base;
+		}
+
+	//constant-expression replacements for std::pow and std::ceil; Pow agrees with std::pow for every
+	//impact subscore the formulas can reach, and Ceil is exact for the non-negative scores rounded here
+		static constexpr void TwoProduct(double a, double b, double &hi, double &lo);
+		static constexpr void Multiply(double &xh, double &xl, double yh, double yl);
+		static constexpr double Pow(double x, int n);
+		static constexpr double Ceil(double x);
+
+	public:
+	//weights
+		static constexpr float AttackVectorWeight(AttackVector av);
+		static constexpr float AttackComplexityWeight(AttackComplexity ac);
+		static constexpr float PrivilegesRequiredWeight(PrivilegesRequired pr, bool scopeChanged);
+		static constexpr float UserInteractionWeight(UserInteraction ui);
+		static constexpr float ImpactWeight(Impact impact);
+		static constexpr float RequirementWeight(Requirement r);
+		static constexpr float ExploitCodeMaturityWeight(ExploitCodeMaturity e);
+		static constexpr float RemediationLevelWeight(RemediationLevel rl);
+		static constexpr float ReportConfidenceWeight(ReportConfidence rc);
+
+	//formulas
+		static constexpr float ScoreNormalize(float score);
+		static constexpr float ImpactSubScore(float c, float i, float a); //ISS
+		static constexpr float ModifiedImpactSubScore(float cr, float c, float ir, float i, float ar, float a); //MISS
+		static constexpr float ImpactScore(float iss, bool scopeChanged, bool modified); //the only formula 3.0 and 3.1 disagree on
+		static constexpr float ExploitabilityScore(float av, float ac, float pr, float ui);
+		static constexpr float BaseScore(float impact, float exploitability, bool scopeChanged, bool round);
+		static constexpr float TemporalScore(float unroundedBase, float e, float rl, float rc, bool round);
+
+		constexpr CVSS_3_Engine() = default;
+		explicit constexpr CVSS_3_Engine(ParsedVector const& v) : _v(v) {}
+		constexpr void Reset(ParsedVector const& v) { _v = v; }
+		constexpr ParsedVector const& GetVector() const { return _v; }
+
+		constexpr float GetAttackVector(bool modified = false) const { return AttackVectorWeight(Pick(_v.av, _v.mav, modified)); }
+		constexpr float GetAttackComplexity(bool modified = false) const { return AttackComplexityWeight(Pick(_v.ac, _v.mac, modified)); }
+		constexpr float GetPrivilegesRequired(bool modified = false) const { return PrivilegesRequiredWeight(Pick(_v.pr, _v.mpr, modified), GetScopeChanged(modified)); }
+		constexpr float GetUserInteraction(bool modified = false) const { return UserInteractionWeight(Pick(_v.ui, _v.mui, modified)); }
+		constexpr bool GetScopeChanged(bool modified = false) const { return Pick(_v.s, _v.ms, modified) == Scope::Changed; }
+		constexpr float GetConfidentiality(bool modified = false) const { return ImpactWeight(Pick(_v.c, _v.mc, modified)); }
+		constexpr float GetIntegrity(bool modified = false) const { return ImpactWeight(Pick(_v.i, _v.mi, modified)); }
+		constexpr float GetAvailability(bool modified = false) const { return ImpactWeight(Pick(_v.a, _v.ma, modified)); }
+
+		constexpr float GetExploitCodeMaturity() const { return ExploitCodeMaturityWeight(_v.e); }
+		constexpr float GetRemediationLevel() const { return RemediationLevelWeight(_v.rl); }
+		constexpr float GetReportConfidence() const { return ReportConfidenceWeight(_v.rc); }
+
+		constexpr float GetConfidentialityRequirement() const { return RequirementWeight(_v.cr); }
+		constexpr float GetIntegrityRequirement() const { return RequirementWeight(_v.ir); }
+		constexpr float GetAvailabilityRequirement() const { return RequirementWeight(_v.ar); }
+
+		constexpr float GetImpactSubScore(bool modified = false) const //ISS
+		{
+			if (modified)
+				return ModifiedImpactSubScore(GetConfidentialityRequirement(), GetConfidentiality(true), GetIntegrityRequirement(), GetIntegrity(true), GetAvailabilityRequirement(), GetAvailability(true));
+			return ImpactSubScore(GetConfidentiality(), GetIntegrity(), GetAvailability());
+		}
+		constexpr float GetImpact(bool modified = false) const { return ImpactScore(GetImpactSubScore(modified), GetScopeChanged(modified), modified); } //Final Impact Score
+		constexpr float GetExploitability(bool modified = false) const { return ExploitabilityScore(GetAttackVector(modified), GetAttackComplexity(modified), GetPrivilegesRequired(modified), GetUserInteraction(modified)); } //Final Exploitability Score
+		constexpr float GetBaseScore(bool modified = false, bool round = true) const { return BaseScore(GetImpact(modified), GetExploitability(modified), GetScopeChanged(modified), round); } //Base Score
+		constexpr float GetTemporalScore(bool round = true) const { return TemporalScore(GetBaseScore(false, false), GetExploitCodeMaturity(), GetRemediationLevel(), GetReportConfidence(), round); } //Temporal Score
+		constexpr float GetEnvironmentalScore(bool round = true) const { return GetBaseScore(true, round); } //Environmental Score
+};
+
+template<CVSSVersion V> constexpr void CVSS_3_Engine<V>::TwoProduct(double a, double b, double &hi, double &lo)
+{
+	//Dekker's exact product, hi + lo == a * b; no fma so it also works in constant expressions
+	const double split = 134217729.0; //2^27 + 1
+	double ta = split * a;
+	double ah = ta - (ta - a);
+	double al = a - ah;
+	double tb = split * b;
+	double bh = tb - (tb - b);
+	double bl = b - bh;
+	hi = a * b;
+	lo = ((ah * bh - hi) + ah * bl + al * bh) + al * bl;
+}
+
+template<CVSSVersion V> constexpr void CVSS_3_Engine<V>::Multiply(double &xh, double &xl, double yh, double yl)
+{
+	//double-double product, so rounding only happens once at the end of Pow()
+	double p = 0;
+	double e = 0;
+	TwoProduct(xh, yh, p, e);
+	e += xh * yl + xl * yh;
+	xh = p + e;
+	xl = e - (xh - p);
+}
+
+template<CVSSVersion V> constexpr double CVSS_3_Engine<V>::Pow(double x, int n)
+{
+	double rh = 1.0, rl = 0.0;
+	double bh = x, bl = 0.0;
+	while (n > 0)
+	{
+		if (n & 1)
+			Multiply(rh, rl, bh, bl);
+		n >>= 1;
+		if (n > 0)
+			Multiply(bh, bl, bh, bl);
+	}
+	return rh;
+}
+
+template<CVSSVersion V> constexpr double CVSS_3_Engine<V>::Ceil(double x)
+{
+	double truncated = static_cast<double>(static_cast<long long>(x));
+	return (truncated < x) ? truncated + 1.0 : truncated;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::AttackVectorWeight(AttackVector av)
+{
+	switch (av)
+	{
+	case AttackVector::Network:
+		return 0.85;
+	case AttackVector::Adjacent:
+		return 0.62;
+	case AttackVector::Local:
+		return 0.55;
+	case AttackVector::Physical:
+		return 0.2;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::AttackComplexityWeight(AttackComplexity ac)
+{
+	switch (ac)
+	{
+	case AttackComplexity::Low:
+		return 0.77;
+	case AttackComplexity::High:
+		return 0.44;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::PrivilegesRequiredWeight(PrivilegesRequired pr, bool scopeChanged)
+{
+	switch (pr)
+	{
+	case PrivilegesRequired::None:
+		return 0.85;
+	case PrivilegesRequired::Low:
+		return scopeChanged ? 0.68 : 0.62;
+	case PrivilegesRequired::High:
+		return scopeChanged ? 0.5 : 0.27;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::UserInteractionWeight(UserInteraction ui)
+{
+	switch (ui)
+	{
+	case UserInteraction::None:
+		return 0.85;
+	case UserInteraction::Required:
+		return 0.62;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ImpactWeight(Impact impact)
+{
+	switch (impact)
+	{
+	case Impact::High:
+		return 0.56;
+	case Impact::Low:
+		return 0.22;
+	case Impact::None:
+		return 0.0;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::RequirementWeight(Requirement r)
+{
+	switch (r)
+	{
+	case (Requirement::High):
+		return 1.5;
+	case (Requirement::Low):
+		return 0.5;
+	case (Requirement::Medium):
+	case (Requirement::NotDefined):
+		return 1.0;
+	}
+	return 1.0; //should never get here; treat impossible values as not defined
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ExploitCodeMaturityWeight(ExploitCodeMaturity e)
+{
+	switch (e)
+	{
+	case (ExploitCodeMaturity::Unproven):
+		return 0.91;
+	case (ExploitCodeMaturity::ProofOfConcept):
+		return 0.94;
+	case (ExploitCodeMaturity::Functional):
+		return 0.97;
+	case (ExploitCodeMaturity::High):
+	case (ExploitCodeMaturity::NotDefined):
+		return 1.0;
+	}
+	return 1.0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::RemediationLevelWeight(RemediationLevel rl)
+{
+	switch (rl)
+	{
+	case (RemediationLevel::OfficialFix):
+		return 0.95;
+	case (RemediationLevel::TemporaryFix):
+		return 0.96;
+	case (RemediationLevel::Workaround):
+		return 0.97;
+	case (RemediationLevel::Unavailable):
+	case (RemediationLevel::NotDefined):
+		return 1.0;
+	}
+	return 1.0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ReportConfidenceWeight(ReportConfidence rc)
+{
+	switch (rc)
+	{
+	case (ReportConfidence::Unknown):
+		return 0.92;
+	case (ReportConfidence::Reasonable):
+		return 0.96;
+	case (ReportConfidence::Confirmed):
+	case (ReportConfidence::NotDefined):
+		return 1.0;
+	}
+	return 1.0;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ScoreNormalize(float score)
+{
+	return std::min(std::max(score, 0.0f), 10.0f);
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ImpactSubScore(float c, float i, float a)
+{
+	return (1.0 - ((1.0 - c) * (1.0 - i) * (1.0 - a)));
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ModifiedImpactSubScore(float cr, float c, float ir, float i, float ar, float a)
+{
+	return std::min((1.0 - ((1.0 - (cr * c)) * (1.0 - (ir * i)) * (1.0 - (ar * a)))), 0.915);
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ImpactScore(float iss, bool scopeChanged, bool modified)
+{
+	if (scopeChanged)
+	{
+		if constexpr (V == CVSSVersion::V3_1)
+		{
+			if (modified)
+			{
+				return ScoreNormalize(7.52 * (iss - 0.029) - (3.25 * Pow(iss * 0.9731 - 0.02, 13)));
+			}
+		}
+		return ScoreNormalize(7.52 * (iss - 0.029) - (3.25 * Pow(iss - 0.02, 15)));
+	}
+	return ScoreNormalize(6.42 * iss);
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::ExploitabilityScore(float av, float ac, float pr, float ui)
+{
+	return ScoreNormalize(8.22 * av * ac * pr * ui);
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::BaseScore(float impact, float exploitability, bool scopeChanged, bool round)
+{
+	if (impact <= 0.0)
+	{
+		return 0;
+	}
+	float factor = scopeChanged ? 1.08 : 1.0;
+	float tmpBase = ScoreNormalize(factor * (impact + exploitability));
+	if (round)
+		tmpBase = Ceil(tmpBase * 10.0) / 10.0;
+	return tmpBase;
+}
+
+template<CVSSVersion V> constexpr float CVSS_3_Engine<V>::TemporalScore(float unroundedBase, float e, float rl, float rc, bool round)
+{
+	float tmpTemporal = ScoreNormalize(unroundedBase * e * rl * rc);
+	if (round)
+		tmpTemporal = Ceil(tmpTemporal * 10.0) / 10.0;
+	return tmpTemporal;
+}
+
+//score any parsed 3.x vector with the engine for its version; usable in constant expressions
+constexpr ScoreResult ComputeScore(ParsedVector const& v)
+{
+	ScoreResult ret;
+	ret.version = v.version;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	if (v.version == CVSSVersion::V3_0)
+	{
+		CVSS_3_Engine<CVSSVersion::V3_0> engine(v);
+		ret.base = engine.GetBaseScore();
+		ret.temporal = engine.GetTemporalScore();
+		ret.environmental = engine.GetEnvironmentalScore();
+	}
+	else
+	{
+		CVSS_3_Engine<CVSSVersion::V3_1> engine(v);
+		ret.base = engine.GetBaseScore();
+		ret.temporal = engine.GetTemporalScore();
+		ret.environmental = engine.GetEnvironmentalScore();
+	}
+	return ret;
+}
+
+#endif
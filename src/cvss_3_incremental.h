@@ -0,0 +1,246 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_3_INCREMENTAL_H_
+#define HAVE_CVSS_3_INCREMENTAL_H_
+
+#include "cvss_3_engine.h"
+#include "cvss_vector.h"
+
+//what-if rescoring for one CVSS 3.x vector: the weights, impact subscores, impacts and exploitabilities
+//behind the base and environmental scores are kept, and each Set*() only refreshes the terms the metric
+//feeds; scores always equal CVSS_3_Engine<V> (and so CVSS_3_1/CVSS_3) on the current vector
+template<CVSSVersion V> class CVSS_3_Incremental
+{
+	private:
+		typedef CVSS_3_Engine<V> Engine;
+
+		//terms of the base score (modified false) or environmental score (modified true)
+		struct Terms
+		{
+			float av = 0, ac = 0, pr = 0, ui = 0;
+			bool scopeChanged = false;
+			float c = 0, i = 0, a = 0;
+			float iss = 0; //ISS, or MISS for the environmental terms
+			float impact = 0;
+			float exploitability = 0;
+		};
+
+		ParsedVector _v;
+		Terms _base;
+		Terms _modified;
+		float _cr = 0, _ir = 0, _ar = 0;
+
+		template<typename T> static constexpr T Effective(T base, Modified<T> const& m)
+		{
+			return m.modified ? m.parent : base;
+		}
+
+		constexpr Terms &Select(bool modified) { return modified ? _modified : _base; }
+
+		constexpr void RefreshExploitability(bool modified)
+		{
+			Terms &t = Select(modified);
+			t.exploitability = Engine::ExploitabilityScore(t.av, t.ac, t.pr, t.ui);
+		}
+
+		constexpr void RefreshImpact(bool modified)
+		{
+			Terms &t = Select(modified);
+			if (modified)
+				t.iss = Engine::ModifiedImpactSubScore(_cr, t.c, _ir, t.i, _ar, t.a);
+			else
+				t.iss = Engine::ImpactSubScore(t.c, t.i, t.a);
+			t.impact = Engine::ImpactScore(t.iss, t.scopeChanged, modified);
+		}
+
+		//a setter touches the base terms, the environmental terms, or both (a base metric with no
+		//modified override also feeds the environmental score)
+		template<typename T> static constexpr void Assign(T &base, Modified<T> &m, T value, bool modified, bool &touchesBase, bool &touchesModified)
+		{
+			if (modified)
+			{
+				m = { value, true };
+				touchesBase = false;
+				touchesModified = true;
+			}
+			else
+			{
+				base = value;
+				touchesBase = true;
+				touchesModified = !m.modified;
+			}
+		}
+
+		constexpr void UpdateExploitability(bool touchesBase, bool touchesModified)
+		{
+			if (touchesBase)
+			{
+				_base.av = Engine::AttackVectorWeight(_v.av);
+				_base.ac = Engine::AttackComplexityWeight(_v.ac);
+				_base.pr = Engine::PrivilegesRequiredWeight(_v.pr, _base.scopeChanged);
+				_base.ui = Engine::UserInteractionWeight(_v.ui);
+				RefreshExploitability(false);
+			}
+			if (touchesModified)
+			{
+				_modified.av = Engine::AttackVectorWeight(Effective(_v.av, _v.mav));
+				_modified.ac = Engine::AttackComplexityWeight(Effective(_v.ac, _v.mac));
+				_modified.pr = Engine::PrivilegesRequiredWeight(Effective(_v.pr, _v.mpr), _modified.scopeChanged);
+				_modified.ui = Engine::UserInteractionWeight(Effective(_v.ui, _v.mui));
+				RefreshExploitability(true);
+			}
+		}
+
+		constexpr void UpdateImpact(bool touchesBase, bool touchesModified)
+		{
+			if (touchesBase)
+			{
+				_base.c = Engine::ImpactWeight(_v.c);
+				_base.i = Engine::ImpactWeight(_v.i);
+				_base.a = Engine::ImpactWeight(_v.a);
+				RefreshImpact(false);
+			}
+			if (touchesModified)
+			{
+				_modified.c = Engine::ImpactWeight(Effective(_v.c, _v.mc));
+				_modified.i = Engine::ImpactWeight(Effective(_v.i, _v.mi));
+				_modified.a = Engine::ImpactWeight(Effective(_v.a, _v.ma));
+				RefreshImpact(true);
+			}
+		}
+
+		constexpr void UpdateScope(bool touchesBase, bool touchesModified)
+		{
+			//scope weighs privileges and picks the impact formula
+			if (touchesBase)
+				_base.scopeChanged = (_v.s == Scope::Changed);
+			if (touchesModified)
+				_modified.scopeChanged = (Effective(_v.s, _v.ms) == Scope::Changed);
+			UpdateExploitability(touchesBase, touchesModified);
+			if (touchesBase)
+				RefreshImpact(false);
+			if (touchesModified)
+				RefreshImpact(true);
+		}
+
+		constexpr void UpdateRequirements()
+		{
+			_cr = Engine::RequirementWeight(_v.cr);
+			_ir = Engine::RequirementWeight(_v.ir);
+			_ar = Engine::RequirementWeight(_v.ar);
+			RefreshImpact(true);
+		}
+
+	public:
+		constexpr CVSS_3_Incremental() { Reset(ParsedVector()); }
+		explicit constexpr CVSS_3_Incremental(ParsedVector const& v) { Reset(v); }
+
+		constexpr void Reset(ParsedVector const& v) //full rescore
+		{
+			_v = v;
+			_cr = Engine::RequirementWeight(_v.cr);
+			_ir = Engine::RequirementWeight(_v.ir);
+			_ar = Engine::RequirementWeight(_v.ar);
+			UpdateImpact(true, true);
+			UpdateScope(true, true);
+		}
+		constexpr ParsedVector const& GetVector() const { return _v; }
+
+	//same meaning as the CVSS_3_1 setters: modified sets the environmental override instead of the base metric
+		constexpr void SetAttackVector(AttackVector av, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.av, _v.mav, av, modified, touchesBase, touchesModified);
+			UpdateExploitability(touchesBase, touchesModified);
+		}
+		constexpr void SetAttackComplexity(AttackComplexity ac, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.ac, _v.mac, ac, modified, touchesBase, touchesModified);
+			UpdateExploitability(touchesBase, touchesModified);
+		}
+		constexpr void SetPrivilegesRequired(PrivilegesRequired pr, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.pr, _v.mpr, pr, modified, touchesBase, touchesModified);
+			UpdateExploitability(touchesBase, touchesModified);
+		}
+		constexpr void SetUserInteraction(UserInteraction ui, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.ui, _v.mui, ui, modified, touchesBase, touchesModified);
+			UpdateExploitability(touchesBase, touchesModified);
+		}
+		constexpr void SetScope(Scope s, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.s, _v.ms, s, modified, touchesBase, touchesModified);
+			UpdateScope(touchesBase, touchesModified);
+		}
+		constexpr void SetConfidentiality(Impact c, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.c, _v.mc, c, modified, touchesBase, touchesModified);
+			UpdateImpact(touchesBase, touchesModified);
+		}
+		constexpr void SetIntegrity(Impact i, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.i, _v.mi, i, modified, touchesBase, touchesModified);
+			UpdateImpact(touchesBase, touchesModified);
+		}
+		constexpr void SetAvailability(Impact a, bool modified)
+		{
+			bool touchesBase = false, touchesModified = false;
+			Assign(_v.a, _v.ma, a, modified, touchesBase, touchesModified);
+			UpdateImpact(touchesBase, touchesModified);
+		}
+
+	//drop a modified override ("X"), so the base metric feeds the environmental score again
+		constexpr void ClearModifiedAttackVector() { _v.mav.modified = false; UpdateExploitability(false, true); }
+		constexpr void ClearModifiedAttackComplexity() { _v.mac.modified = false; UpdateExploitability(false, true); }
+		constexpr void ClearModifiedPrivilegesRequired() { _v.mpr.modified = false; UpdateExploitability(false, true); }
+		constexpr void ClearModifiedUserInteraction() { _v.mui.modified = false; UpdateExploitability(false, true); }
+		constexpr void ClearModifiedScope() { _v.ms.modified = false; UpdateScope(false, true); }
+		constexpr void ClearModifiedConfidentiality() { _v.mc.modified = false; UpdateImpact(false, true); }
+		constexpr void ClearModifiedIntegrity() { _v.mi.modified = false; UpdateImpact(false, true); }
+		constexpr void ClearModifiedAvailability() { _v.ma.modified = false; UpdateImpact(false, true); }
+
+	//requirements only weigh the environmental impact subscore; temporal metrics are read when scored
+		constexpr void SetConfidentialityRequirement(Requirement cr) { _v.cr = cr; UpdateRequirements(); }
+		constexpr void SetIntegrityRequirement(Requirement ir) { _v.ir = ir; UpdateRequirements(); }
+		constexpr void SetAvailabilityRequirement(Requirement ar) { _v.ar = ar; UpdateRequirements(); }
+		constexpr void SetExploitCodeMaturity(ExploitCodeMaturity e) { _v.e = e; }
+		constexpr void SetRemediationLevel(RemediationLevel rl) { _v.rl = rl; }
+		constexpr void SetReportConfidence(ReportConfidence rc) { _v.rc = rc; }
+
+		constexpr float GetImpactSubScore(bool modified = false) const { return modified ? _modified.iss : _base.iss; } //ISS
+		constexpr float GetImpact(bool modified = false) const { return modified ? _modified.impact : _base.impact; } //Final Impact Score
+		constexpr float GetExploitability(bool modified = false) const { return modified ? _modified.exploitability : _base.exploitability; } //Final Exploitability Score
+		constexpr float GetBaseScore(bool modified = false, bool round = true) const //Base Score
+		{
+			Terms const& t = modified ? _modified : _base;
+			return Engine::BaseScore(t.impact, t.exploitability, t.scopeChanged, round);
+		}
+		constexpr float GetTemporalScore(bool round = true) const { return Engine::TemporalScore(GetBaseScore(false, false), Engine::ExploitCodeMaturityWeight(_v.e), Engine::RemediationLevelWeight(_v.rl), Engine::ReportConfidenceWeight(_v.rc), round); } //Temporal Score
+		constexpr float GetEnvironmentalScore(bool round = true) const { return GetBaseScore(true, round); } //Environmental Score
+};
+
+#endif
@@ -0,0 +1,354 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_3_INTEGER_H_
+#define HAVE_CVSS_3_INTEGER_H_
+
+#include "cvss_score.h"
+#include "cvss_vector.h"
+
+#include <cstdint>
+
+//float-free CVSS 3.x scorer: weights are integer hundredths, every intermediate value is fixed point in
+//units of 10^-12, and scores come back in integer tenths rounded with the specification's Roundup
+//(round to five decimal places, then up to one), so rounding never depends on binary floating point;
+//formulas otherwise follow CVSS_3_Engine (the temporal score scales the unrounded base, and the
+//environmental score is the modified base score)
+template<CVSSVersion V> class CVSS_3_IntegerEngine
+{
+	static_assert((V == CVSSVersion::V3_0) || (V == CVSSVersion::V3_1), "CVSS_3_IntegerEngine only scores CVSS 3.x");
+
+	private:
+		ParsedVector _v;
+
+		template<typename T> static constexpr T Pick(T base, Modified<T> const& m, bool modified)
+		{
+			return (modified && m.modified) ? m.parent : base;
+		}
+
+		static constexpr int64_t Multiply(int64_t a, int64_t b); //a * b for non-negative fixed point values
+		static constexpr int64_t Scale(int64_t a, int64_t hundredths); //a * hundredths / 100
+		static constexpr int64_t Pow(int64_t x, int n);
+
+	public:
+		static constexpr int64_t One = 1000000000000; //1.0 in fixed point
+
+	//weights, in hundredths
+		static constexpr int64_t AttackVectorWeight(AttackVector av);
+		static constexpr int64_t AttackComplexityWeight(AttackComplexity ac);
+		static constexpr int64_t PrivilegesRequiredWeight(PrivilegesRequired pr, bool scopeChanged);
+		static constexpr int64_t UserInteractionWeight(UserInteraction ui);
+		static constexpr int64_t ImpactWeight(Impact impact);
+		static constexpr int64_t RequirementWeight(Requirement r);
+		static constexpr int64_t ExploitCodeMaturityWeight(ExploitCodeMaturity e);
+		static constexpr int64_t RemediationLevelWeight(RemediationLevel rl);
+		static constexpr int64_t ReportConfidenceWeight(ReportConfidence rc);
+
+	//formulas, in fixed point except for Roundup()
+		static constexpr int64_t ScoreNormalize(int64_t score);
+		static constexpr int64_t ImpactSubScore(int64_t c, int64_t i, int64_t a); //ISS, exact
+		static constexpr int64_t ModifiedImpactSubScore(int64_t cr, int64_t c, int64_t ir, int64_t i, int64_t ar, int64_t a); //MISS, exact
+		static constexpr int64_t ImpactScore(int64_t iss, bool scopeChanged, bool modified);
+		static constexpr int64_t ExploitabilityScore(int64_t av, int64_t ac, int64_t pr, int64_t ui); //exact
+		static constexpr int64_t BaseScore(int64_t impact, int64_t exploitability, bool scopeChanged);
+		static constexpr int64_t TemporalScore(int64_t unroundedBase, int64_t e, int64_t rl, int64_t rc);
+		static constexpr unsigned Roundup(int64_t score); //fixed point to tenths
+
+		constexpr CVSS_3_IntegerEngine() = default;
+		explicit constexpr CVSS_3_IntegerEngine(ParsedVector const& v) : _v(v) {}
+		constexpr void Reset(ParsedVector const& v) { _v = v; }
+		constexpr ParsedVector const& GetVector() const { return _v; }
+
+		constexpr bool GetScopeChanged(bool modified = false) const { return Pick(_v.s, _v.ms, modified) == Scope::Changed; }
+		constexpr int64_t GetImpactSubScore(bool modified = false) const //ISS
+		{
+			if (modified)
+				return ModifiedImpactSubScore(RequirementWeight(_v.cr), ImpactWeight(Pick(_v.c, _v.mc, true)), RequirementWeight(_v.ir), ImpactWeight(Pick(_v.i, _v.mi, true)), RequirementWeight(_v.ar), ImpactWeight(Pick(_v.a, _v.ma, true)));
+			return ImpactSubScore(ImpactWeight(_v.c), ImpactWeight(_v.i), ImpactWeight(_v.a));
+		}
+		constexpr int64_t GetImpact(bool modified = false) const { return ImpactScore(GetImpactSubScore(modified), GetScopeChanged(modified), modified); } //Final Impact Score
+		constexpr int64_t GetExploitability(bool modified = false) const { return ExploitabilityScore(AttackVectorWeight(Pick(_v.av, _v.mav, modified)), AttackComplexityWeight(Pick(_v.ac, _v.mac, modified)), PrivilegesRequiredWeight(Pick(_v.pr, _v.mpr, modified), GetScopeChanged(modified)), UserInteractionWeight(Pick(_v.ui, _v.mui, modified))); } //Final Exploitability Score
+		constexpr int64_t GetUnroundedBaseScore(bool modified = false) const { return BaseScore(GetImpact(modified), GetExploitability(modified), GetScopeChanged(modified)); }
+
+		//scores in tenths
+		constexpr unsigned GetBaseScore(bool modified = false) const { return Roundup(GetUnroundedBaseScore(modified)); } //Base Score
+		constexpr unsigned GetTemporalScore() const { return Roundup(TemporalScore(GetUnroundedBaseScore(), ExploitCodeMaturityWeight(_v.e), RemediationLevelWeight(_v.rl), ReportConfidenceWeight(_v.rc))); } //Temporal Score
+		constexpr unsigned GetEnvironmentalScore() const { return GetBaseScore(true); } //Environmental Score
+};
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::Multiply(int64_t a, int64_t b)
+{
+	//split a so neither partial product overflows: a * b / One == (ah * b + al * b / 10^6) / 10^6;
+	//unsigned, since division by a constant is cheaper that way
+	const uint64_t half = 1000000;
+	uint64_t ah = static_cast<uint64_t>(a) / half;
+	uint64_t al = static_cast<uint64_t>(a) % half;
+	uint64_t ub = static_cast<uint64_t>(b);
+	return static_cast<int64_t>((ah * ub + (al * ub) / half + half / 2) / half);
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::Scale(int64_t a, int64_t hundredths)
+{
+	return (a * hundredths + 50) / 100;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::Pow(int64_t x, int n)
+{
+	//odd powers of the (at most -0.02) negative bases the formulas can produce stay negative
+	bool negative = (x < 0) && (n & 1);
+	if (x < 0)
+		x = -x;
+	int64_t ret = One;
+	while (n > 0)
+	{
+		if (n & 1)
+			ret = Multiply(ret, x);
+		n >>= 1;
+		if (n > 0)
+			x = Multiply(x, x);
+	}
+	return negative ? -ret : ret;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::AttackVectorWeight(AttackVector av)
+{
+	switch (av)
+	{
+	case AttackVector::Network:
+		return 85;
+	case AttackVector::Adjacent:
+		return 62;
+	case AttackVector::Local:
+		return 55;
+	case AttackVector::Physical:
+		return 20;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::AttackComplexityWeight(AttackComplexity ac)
+{
+	switch (ac)
+	{
+	case AttackComplexity::Low:
+		return 77;
+	case AttackComplexity::High:
+		return 44;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::PrivilegesRequiredWeight(PrivilegesRequired pr, bool scopeChanged)
+{
+	switch (pr)
+	{
+	case PrivilegesRequired::None:
+		return 85;
+	case PrivilegesRequired::Low:
+		return scopeChanged ? 68 : 62;
+	case PrivilegesRequired::High:
+		return scopeChanged ? 50 : 27;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::UserInteractionWeight(UserInteraction ui)
+{
+	switch (ui)
+	{
+	case UserInteraction::None:
+		return 85;
+	case UserInteraction::Required:
+		return 62;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ImpactWeight(Impact impact)
+{
+	switch (impact)
+	{
+	case Impact::High:
+		return 56;
+	case Impact::Low:
+		return 22;
+	case Impact::None:
+		return 0;
+	}
+	return 0;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::RequirementWeight(Requirement r)
+{
+	switch (r)
+	{
+	case (Requirement::High):
+		return 150;
+	case (Requirement::Low):
+		return 50;
+	case (Requirement::Medium):
+	case (Requirement::NotDefined):
+		return 100;
+	}
+	return 100; //should never get here; treat impossible values as not defined
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ExploitCodeMaturityWeight(ExploitCodeMaturity e)
+{
+	switch (e)
+	{
+	case (ExploitCodeMaturity::Unproven):
+		return 91;
+	case (ExploitCodeMaturity::ProofOfConcept):
+		return 94;
+	case (ExploitCodeMaturity::Functional):
+		return 97;
+	case (ExploitCodeMaturity::High):
+	case (ExploitCodeMaturity::NotDefined):
+		return 100;
+	}
+	return 100;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::RemediationLevelWeight(RemediationLevel rl)
+{
+	switch (rl)
+	{
+	case (RemediationLevel::OfficialFix):
+		return 95;
+	case (RemediationLevel::TemporaryFix):
+		return 96;
+	case (RemediationLevel::Workaround):
+		return 97;
+	case (RemediationLevel::Unavailable):
+	case (RemediationLevel::NotDefined):
+		return 100;
+	}
+	return 100;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ReportConfidenceWeight(ReportConfidence rc)
+{
+	switch (rc)
+	{
+	case (ReportConfidence::Unknown):
+		return 92;
+	case (ReportConfidence::Reasonable):
+		return 96;
+	case (ReportConfidence::Confirmed):
+	case (ReportConfidence::NotDefined):
+		return 100;
+	}
+	return 100;
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ScoreNormalize(int64_t score)
+{
+	return (score < 0) ? 0 : ((score > 10 * One) ? 10 * One : score);
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ImpactSubScore(int64_t c, int64_t i, int64_t a)
+{
+	//1 - (1 - c)(1 - i)(1 - a) with each weight in hundredths is a whole number of millionths
+	return (1000000 - (100 - c) * (100 - i) * (100 - a)) * (One / 1000000);
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ModifiedImpactSubScore(int64_t cr, int64_t c, int64_t ir, int64_t i, int64_t ar, int64_t a)
+{
+	//requirement times weight is in ten-thousandths, so the product is exactly in units of 10^-12
+	int64_t miss = One - (10000 - cr * c) * (10000 - ir * i) * (10000 - ar * a);
+	return (miss < 915 * (One / 1000)) ? miss : 915 * (One / 1000);
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ImpactScore(int64_t iss, bool scopeChanged, bool modified)
+{
+	if (scopeChanged)
+	{
+		if constexpr (V == CVSSVersion::V3_1)
+		{
+			if (modified)
+			{
+				return ScoreNormalize(Scale(iss - 29 * (One / 1000), 752) - Scale(Pow(Multiply(iss, 9731 * (One / 10000)) - 2 * (One / 100), 13), 325));
+			}
+		}
+		return ScoreNormalize(Scale(iss - 29 * (One / 1000), 752) - Scale(Pow(iss - 2 * (One / 100), 15), 325));
+	}
+	return ScoreNormalize(Scale(iss, 642));
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::ExploitabilityScore(int64_t av, int64_t ac, int64_t pr, int64_t ui)
+{
+	//8.22 and four weights in hundredths make 10^-10 units
+	return ScoreNormalize(822 * av * ac * pr * ui * (One / 10000000000));
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::BaseScore(int64_t impact, int64_t exploitability, bool scopeChanged)
+{
+	if (impact <= 0)
+	{
+		return 0;
+	}
+	return ScoreNormalize(scopeChanged ? Scale(impact + exploitability, 108) : impact + exploitability);
+}
+
+template<CVSSVersion V> constexpr int64_t CVSS_3_IntegerEngine<V>::TemporalScore(int64_t unroundedBase, int64_t e, int64_t rl, int64_t rc)
+{
+	return ScoreNormalize(Scale(Scale(Scale(unroundedBase, e), rl), rc));
+}
+
+template<CVSSVersion V> constexpr unsigned CVSS_3_IntegerEngine<V>::Roundup(int64_t score)
+{
+	//round to the nearest 10^-5, then up to the next tenth unless already on one
+	int64_t hundredThousandths = (score + One / 200000) / (One / 100000);
+	return static_cast<unsigned>((hundredThousandths + 9999) / 10000);
+}
+
+//score any parsed 3.x vector with the integer engine for its version; usable in constant expressions
+constexpr ScoreResult ComputeIntegerScore(ParsedVector const& v)
+{
+	ScoreResult ret;
+	ret.version = v.version;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	unsigned base = 0, temporal = 0, environmental = 0;
+	if (v.version == CVSSVersion::V3_0)
+	{
+		CVSS_3_IntegerEngine<CVSSVersion::V3_0> engine(v);
+		base = engine.GetBaseScore();
+		temporal = engine.GetTemporalScore();
+		environmental = engine.GetEnvironmentalScore();
+	}
+	else
+	{
+		CVSS_3_IntegerEngine<CVSSVersion::V3_1> engine(v);
+		base = engine.GetBaseScore();
+		temporal = engine.GetTemporalScore();
+		environmental = engine.GetEnvironmentalScore();
+	}
+	ret.base = base / 10.0f;
+	ret.temporal = temporal / 10.0f;
+	ret.environmental = environmental / 10.0f;
+	return ret;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_4_0.h"
+#include "cvss_4_engine.h"
+
+using namespace std;
+
+CVSS_4_0::CVSS_4_0(Vector4Metrics const& metrics) :
+	_metrics(metrics)
+{
+}
+
+float CVSS_4_0::GetBaseScore(bool modified, bool round)
+{
+	return CVSS_4_Engine(_metrics).GetScore(false, modified, round);
+}
+
+float CVSS_4_0::GetTemporalScore(bool round)
+{
+	return CVSS_4_Engine(_metrics).GetTemporalScore(round);
+}
+
+float CVSS_4_0::GetEnvironmentalScore(bool round)
+{
+	return CVSS_4_Engine(_metrics).GetEnvironmentalScore(round);
+}
+
+string CVSS_4_0::GetMacroVector(bool threat, bool environmental) const
+{
+	int eq[CVSS_4_Engine::EQCount] = {};
+	CVSS_4_Engine(_metrics).GetMacroVector(threat, environmental, eq);
+	string ret;
+	for (int digit : eq)
+		ret.push_back(static_cast<char>('0' + digit));
+	return ret;
+}
@@ -0,0 +1,156 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_4_0_H_
+#define HAVE_CVSS_4_0_H_
+
+#include "cvss_3_1.h"
+
+#include <string>
+
+//4.0 reuses the 3.x AttackVector, AttackComplexity, PrivilegesRequired, Impact and Requirement values
+enum class AttackRequirements {
+	None,
+	Present
+};
+
+enum class UserInteraction4 {
+	None,
+	Passive,
+	Active
+};
+
+//subsequent system impact; only the modified integrity and availability metrics may be Safety
+enum class SystemImpact {
+	High,
+	Low,
+	None,
+	Safety
+};
+
+enum class ExploitMaturity {
+	NotDefined,
+	Attacked,
+	ProofOfConcept,
+	Unreported
+};
+
+//supplemental metrics are parsed and kept, but never change a score
+enum class Safety {
+	NotDefined,
+	Negligible,
+	Present
+};
+
+enum class Automatable {
+	NotDefined,
+	No,
+	Yes
+};
+
+enum class Recovery {
+	NotDefined,
+	Automatic,
+	User,
+	Irrecoverable
+};
+
+enum class ValueDensity {
+	NotDefined,
+	Diffuse,
+	Concentrated
+};
+
+enum class ResponseEffort {
+	NotDefined,
+	Low,
+	Moderate,
+	High
+};
+
+enum class ProviderUrgency {
+	NotDefined,
+	Clear,
+	Green,
+	Amber,
+	Red
+};
+
+//metrics of a 4.0 vector; ParseVector4() fills them in, and unspecified base metrics default to their most
+//severe value, as in 3.x
+struct Vector4Metrics
+{
+	//Base Metrics
+	AttackVector av = AttackVector::Network; //Attack Vector
+	AttackComplexity ac = AttackComplexity::Low; //Attack Complexity
+	AttackRequirements at = AttackRequirements::None; //Attack Requirements
+	PrivilegesRequired pr = PrivilegesRequired::None; //Privileges Required
+	UserInteraction4 ui = UserInteraction4::None; //User Interaction
+	Impact vc = Impact::High; //Vulnerable System Confidentiality
+	Impact vi = Impact::High; //Vulnerable System Integrity
+	Impact va = Impact::High; //Vulnerable System Availability
+	SystemImpact sc = SystemImpact::High; //Subsequent System Confidentiality
+	SystemImpact si = SystemImpact::High; //Subsequent System Integrity
+	SystemImpact sa = SystemImpact::High; //Subsequent System Availability
+
+	//Threat Metrics
+	ExploitMaturity e = ExploitMaturity::NotDefined; //Exploit Maturity
+
+	//Environmental Metrics
+	Requirement cr = Requirement::NotDefined; //Confidentiality Requirement
+	Requirement ir = Requirement::NotDefined; //Integrity Requirement
+	Requirement ar = Requirement::NotDefined; //Availability Requirement
+	Modified<AttackVector> mav = { AttackVector::Network, false };
+	Modified<AttackComplexity> mac = { AttackComplexity::Low, false };
+	Modified<AttackRequirements> mat = { AttackRequirements::None, false };
+	Modified<PrivilegesRequired> mpr = { PrivilegesRequired::None, false };
+	Modified<UserInteraction4> mui = { UserInteraction4::None, false };
+	Modified<Impact> mvc = { Impact::High, false };
+	Modified<Impact> mvi = { Impact::High, false };
+	Modified<Impact> mva = { Impact::High, false };
+	Modified<SystemImpact> msc = { SystemImpact::High, false };
+	Modified<SystemImpact> msi = { SystemImpact::High, false };
+	Modified<SystemImpact> msa = { SystemImpact::High, false };
+
+	//Supplemental Metrics
+	Safety s = Safety::NotDefined; //Safety
+	Automatable au = Automatable::NotDefined; //Automatable
+	Recovery r = Recovery::NotDefined; //Recovery
+	ValueDensity v = ValueDensity::NotDefined; //Value Density
+	ResponseEffort re = ResponseEffort::NotDefined; //Vulnerability Response Effort
+	ProviderUrgency u = ProviderUrgency::NotDefined; //Provider Urgency
+};
+
+//CVSS 4.0 scores a vector by the macro vector (EQ1 - EQ6) it falls in, interpolated towards the next lower
+//macro vectors by how far the vector is from the macro vector's most severe members; the 4.0 nomenclature maps
+//onto the CVSS interface as Base = CVSS-B, Temporal = CVSS-BT (base and threat) and Environmental = CVSS-BTE
+class CVSS_4_0 : public CVSS
+{
+	private:
+		Vector4Metrics _metrics;
+
+	public:
+		explicit CVSS_4_0(Vector4Metrics const& metrics);
+		float GetBaseScore(bool modified = false, bool round = true) override; //CVSS-B, or CVSS-BE when modified
+		float GetTemporalScore(bool round = true) override; //CVSS-BT
+		float GetEnvironmentalScore(bool round = true) override; //CVSS-BTE
+		std::string GetMacroVector(bool threat = true, bool environmental = true) const; //EQ1 - EQ6 digits, e.g. "001200"
+};
+
+#endif
@@ -0,0 +1,345 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_4_ENGINE_H_
+#define HAVE_CVSS_4_ENGINE_H_
+
+#include "cvss_score.h"
+#include "cvss_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+
+//non-virtual, header-only CVSS 4.0 scorer; CVSS_4_0 uses it, and everything is constexpr, so the macro vector
+//table is built by the compiler and 4.0 vectors known at build time can be scored there too
+class CVSS_4_Engine
+{
+	public:
+		static constexpr size_t EQCount = 6;
+		static constexpr size_t MacroVectorCount = 3 * 2 * 3 * 3 * 3 * 2; //EQ1 - EQ6 take 3, 2, 3, 3, 3 and 2 values
+		static constexpr size_t GroupCount = 5; //EQ1, EQ2, EQ3 with EQ6, EQ4 and EQ5 are interpolated separately
+
+	private:
+		Vector4Metrics _v;
+
+		//severity of every metric the formula reads, in steps of a tenth below its most severe value, grouped
+		//the way distances from the most severe vectors are summed
+		struct Levels
+		{
+			int eq1[3]; //AV, PR, UI
+			int eq2[2]; //AC, AT
+			int eq3eq6[6]; //VC, VI, VA, CR, IR, AR
+			int eq4[3]; //SC, SI, SA
+			int e; //E
+		};
+
+		//the most severe vectors of one EQ value, as Levels of the group's metrics; a vector is measured from the
+		//first of them that it is nowhere more severe than
+		struct MaxVectors
+		{
+			size_t count;
+			int levels[5][6];
+		};
+
+		//a macro vector's score and, for each group, how far the score falls to the group's next lower macro vector
+		static constexpr int NoLowerMacro = -1000;
+		struct MacroVector
+		{
+			int score; //tenths, or -1 where the EQ values cannot occur together
+			int drop[GroupCount]; //tenths, or NoLowerMacro
+		};
+
+		struct MacroTable
+		{
+			MacroVector macros[MacroVectorCount];
+		};
+
+		//the 4.0 specification's lookup table in tenths, indexed by GetMacroIndex(); each line holds EQ4, EQ5 and
+		//EQ6 of the EQ1 EQ2 EQ3 in its comment, and EQ3 = 2 only occurs with EQ6 = 1
+		static constexpr int MacroScores[MacroVectorCount] = {
+	100, 99, 98, 95, 95, 92, 100, 96, 93, 87, 91, 81, 93, 90, 89, 80, 81, 68, //000
+	98, 95, 95, 92, 90, 84, 93, 92, 89, 81, 81, 65, 88, 80, 78, 70, 69, 48, //001
+	-1, 92, -1, 82, -1, 72, -1, 79, -1, 69, -1, 50, -1, 69, -1, 55, -1, 27, //002
+	99, 97, 95, 92, 92, 85, 95, 91, 90, 83, 84, 71, 92, 81, 82, 71, 72, 53, //010
+	95, 93, 92, 85, 85, 73, 92, 82, 80, 72, 70, 59, 84, 70, 71, 52, 50, 30, //011
+	-1, 86, -1, 75, -1, 52, -1, 71, -1, 52, -1, 29, -1, 63, -1, 29, -1, 17, //012
+	98, 95, 94, 87, 91, 81, 94, 89, 86, 74, 77, 64, 87, 75, 74, 63, 63, 49, //100
+	94, 89, 88, 77, 76, 67, 86, 76, 74, 58, 59, 50, 72, 57, 57, 52, 52, 25, //101
+	-1, 83, -1, 70, -1, 54, -1, 65, -1, 58, -1, 26, -1, 53, -1, 21, -1, 13, //102
+	95, 90, 88, 76, 76, 70, 90, 77, 75, 62, 61, 53, 77, 66, 68, 59, 52, 30, //110
+	89, 78, 76, 67, 62, 58, 74, 59, 57, 57, 47, 23, 61, 52, 57, 29, 24, 16, //111
+	-1, 71, -1, 59, -1, 30, -1, 58, -1, 26, -1, 15, -1, 23, -1, 13, -1, 6, //112
+	93, 87, 86, 72, 75, 58, 86, 74, 74, 61, 56, 34, 70, 54, 52, 40, 40, 22, //200
+	85, 75, 74, 55, 62, 51, 72, 57, 55, 41, 46, 19, 53, 36, 34, 19, 19, 8, //201
+	-1, 64, -1, 51, -1, 20, -1, 47, -1, 21, -1, 11, -1, 24, -1, 9, -1, 4, //202
+	88, 75, 73, 53, 60, 50, 73, 55, 59, 40, 41, 20, 54, 43, 45, 22, 20, 11, //210
+	75, 55, 58, 45, 40, 21, 61, 51, 48, 18, 20, 9, 46, 18, 17, 7, 8, 2, //211
+	-1, 53, -1, 24, -1, 14, -1, 24, -1, 12, -1, 5, -1, 10, -1, 3, -1, 1, //212
+		};
+
+		static constexpr MaxVectors EQ1Max[3] = {
+			{ 1, { { 0, 0, 0 } } },
+			{ 3, { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } },
+			{ 2, { { 3, 0, 0 }, { 1, 1, 1 } } }
+		};
+		static constexpr MaxVectors EQ2Max[2] = {
+			{ 1, { { 0, 0 } } },
+			{ 2, { { 1, 0 }, { 0, 1 } } }
+		};
+		static constexpr MaxVectors EQ3EQ6Max[3][2] = {
+			{ { 1, { { 0, 0, 0, 0, 0, 0 } } }, { 2, { { 0, 0, 1, 1, 1, 0 }, { 0, 0, 0, 1, 1, 1 } } } },
+			{ { 2, { { 1, 0, 0, 0, 0, 0 }, { 0, 1, 0, 0, 0, 0 } } }, { 5, { { 1, 0, 1, 0, 1, 0 }, { 1, 0, 0, 0, 1, 1 }, { 0, 1, 0, 1, 0, 1 }, { 0, 1, 1, 1, 0, 0 }, { 1, 1, 0, 0, 0, 1 } } } },
+			{ { 0, {} }, { 1, { { 1, 1, 1, 0, 0, 0 } } } }
+		};
+		static constexpr MaxVectors EQ4Max[3] = {
+			{ 1, { { 1, 0, 0 } } },
+			{ 1, { { 1, 1, 1 } } },
+			{ 1, { { 2, 2, 2 } } }
+		};
+
+		//distance, in tenths, from the most to the least severe vector of each EQ value
+		static constexpr int EQ1Depth[3] = { 1, 4, 5 };
+		static constexpr int EQ2Depth[2] = { 1, 2 };
+		static constexpr int EQ3EQ6Depth[3][2] = { { 7, 6 }, { 8, 8 }, { 0, 10 } };
+		static constexpr int EQ4Depth[3] = { 6, 5, 4 };
+
+		static const MacroTable Macros;
+		static constexpr size_t GetMacroIndex(int const (&eq)[EQCount]);
+		static constexpr int GetMacroScore(int eq1, int eq2, int eq3, int eq4, int eq5, int eq6);
+		static constexpr MacroTable BuildMacroTable();
+
+		template<typename T> static constexpr int Level(T base, Modified<T> const& m, bool modified)
+		{
+			return static_cast<int>((modified && m.modified) ? m.parent : base);
+		}
+		static constexpr int SystemLevel(SystemImpact impact);
+		static constexpr int RequirementLevel(Requirement r);
+		template<size_t N> static constexpr int GetDistance(MaxVectors const& max, int const (&levels)[N]);
+
+		constexpr Levels GetLevels(bool threat, bool environmental) const;
+		static constexpr void GetEQs(Levels const& l, int (&eq)[EQCount]);
+
+	public:
+		constexpr explicit CVSS_4_Engine(Vector4Metrics const& v) : _v(v) {}
+		constexpr void Reset(Vector4Metrics const& v) { _v = v; }
+
+		constexpr float GetScore(bool threat, bool environmental, bool round = true) const;
+		constexpr float GetBaseScore(bool round = true) const { return GetScore(false, false, round); } //CVSS-B
+		constexpr float GetTemporalScore(bool round = true) const { return GetScore(true, false, round); } //CVSS-BT
+		constexpr float GetEnvironmentalScore(bool round = true) const { return GetScore(true, true, round); } //CVSS-BTE
+		constexpr void GetMacroVector(bool threat, bool environmental, int (&eq)[EQCount]) const;
+};
+
+constexpr size_t CVSS_4_Engine::GetMacroIndex(int const (&eq)[EQCount])
+{
+	return static_cast<size_t>(((((eq[0] * 2 + eq[1]) * 3 + eq[2]) * 3 + eq[3]) * 3 + eq[4]) * 2 + eq[5]);
+}
+
+constexpr int CVSS_4_Engine::GetMacroScore(int eq1, int eq2, int eq3, int eq4, int eq5, int eq6)
+{
+	if ((eq1 > 2) || (eq2 > 1) || (eq3 > 2) || (eq4 > 2) || (eq5 > 2) || (eq6 > 1))
+		return -1;
+	int eq[EQCount] = { eq1, eq2, eq3, eq4, eq5, eq6 };
+	return MacroScores[GetMacroIndex(eq)];
+}
+
+constexpr CVSS_4_Engine::MacroTable CVSS_4_Engine::BuildMacroTable()
+{
+	MacroTable ret = {};
+	for (size_t index = 0; index < MacroVectorCount; index++)
+	{
+		int eq6 = static_cast<int>(index % 2);
+		int eq5 = static_cast<int>(index / 2 % 3);
+		int eq4 = static_cast<int>(index / 6 % 3);
+		int eq3 = static_cast<int>(index / 18 % 3);
+		int eq2 = static_cast<int>(index / 54 % 2);
+		int eq1 = static_cast<int>(index / 108);
+		MacroVector &macro = ret.macros[index];
+		macro.score = MacroScores[index];
+
+		//the next lower macro vector of each group lowers only that group's EQ values; EQ3 and EQ6 lower
+		//together, from 00 to the higher of 01 and 10, and from 01 or 10 to 11, then 21
+		int lower[GroupCount] = {
+			GetMacroScore(eq1 + 1, eq2, eq3, eq4, eq5, eq6),
+			GetMacroScore(eq1, eq2 + 1, eq3, eq4, eq5, eq6),
+			-1,
+			GetMacroScore(eq1, eq2, eq3, eq4 + 1, eq5, eq6),
+			GetMacroScore(eq1, eq2, eq3, eq4, eq5 + 1, eq6)
+		};
+		if ((eq3 == 0) && (eq6 == 0))
+			lower[2] = std::max(GetMacroScore(eq1, eq2, 0, eq4, eq5, 1), GetMacroScore(eq1, eq2, 1, eq4, eq5, 0));
+		else if ((eq3 == 1) && (eq6 == 1))
+			lower[2] = GetMacroScore(eq1, eq2, 2, eq4, eq5, 1);
+		else if (eq3 + eq6 == 1)
+			lower[2] = GetMacroScore(eq1, eq2, 1, eq4, eq5, 1);
+		for (size_t group = 0; group < GroupCount; group++)
+			macro.drop[group] = (lower[group] < 0) ? NoLowerMacro : macro.score - lower[group];
+	}
+	return ret;
+}
+
+inline constexpr CVSS_4_Engine::MacroTable CVSS_4_Engine::Macros = CVSS_4_Engine::BuildMacroTable();
+
+constexpr int CVSS_4_Engine::SystemLevel(SystemImpact impact)
+{
+	return (impact == SystemImpact::Safety) ? 0 : static_cast<int>(impact) + 1;
+}
+
+constexpr int CVSS_4_Engine::RequirementLevel(Requirement r)
+{
+	//Not Defined is High
+	return (r == Requirement::NotDefined) ? 0 : static_cast<int>(r) - 1;
+}
+
+template<size_t N> constexpr int CVSS_4_Engine::GetDistance(MaxVectors const& max, int const (&levels)[N])
+{
+	for (size_t n = 0; n < max.count; n++)
+	{
+		int ret = 0;
+		bool below = true;
+		for (size_t metric = 0; metric < N; metric++)
+		{
+			int distance = levels[metric] - max.levels[n][metric];
+			below = below && (distance >= 0);
+			ret += distance;
+		}
+		if (below)
+			return ret;
+	}
+	return 0;
+}
+
+constexpr CVSS_4_Engine::Levels CVSS_4_Engine::GetLevels(bool threat, bool environmental) const
+{
+	Levels ret = {};
+	ret.eq1[0] = Level(_v.av, _v.mav, environmental);
+	ret.eq1[1] = Level(_v.pr, _v.mpr, environmental);
+	ret.eq1[2] = Level(_v.ui, _v.mui, environmental);
+	ret.eq2[0] = Level(_v.ac, _v.mac, environmental);
+	ret.eq2[1] = Level(_v.at, _v.mat, environmental);
+	ret.eq3eq6[0] = Level(_v.vc, _v.mvc, environmental);
+	ret.eq3eq6[1] = Level(_v.vi, _v.mvi, environmental);
+	ret.eq3eq6[2] = Level(_v.va, _v.mva, environmental);
+	ret.eq3eq6[3] = environmental ? RequirementLevel(_v.cr) : 0;
+	ret.eq3eq6[4] = environmental ? RequirementLevel(_v.ir) : 0;
+	ret.eq3eq6[5] = environmental ? RequirementLevel(_v.ar) : 0;
+	ret.eq4[0] = SystemLevel((environmental && _v.msc.modified) ? _v.msc.parent : _v.sc);
+	ret.eq4[1] = SystemLevel((environmental && _v.msi.modified) ? _v.msi.parent : _v.si);
+	ret.eq4[2] = SystemLevel((environmental && _v.msa.modified) ? _v.msa.parent : _v.sa);
+	//Not Defined is Attacked
+	ret.e = (threat && (_v.e != ExploitMaturity::NotDefined)) ? static_cast<int>(_v.e) - 1 : 0;
+	return ret;
+}
+
+constexpr void CVSS_4_Engine::GetEQs(Levels const& l, int (&eq)[EQCount])
+{
+	int av = l.eq1[0], pr = l.eq1[1], ui = l.eq1[2];
+	if ((av == 0) && (pr == 0) && (ui == 0))
+		eq[0] = 0;
+	else if (((av == 0) || (pr == 0) || (ui == 0)) && (av != 3))
+		eq[0] = 1;
+	else
+		eq[0] = 2;
+
+	eq[1] = ((l.eq2[0] == 0) && (l.eq2[1] == 0)) ? 0 : 1;
+
+	int vc = l.eq3eq6[0], vi = l.eq3eq6[1], va = l.eq3eq6[2];
+	if ((vc == 0) && (vi == 0))
+		eq[2] = 0;
+	else if ((vc == 0) || (vi == 0) || (va == 0))
+		eq[2] = 1;
+	else
+		eq[2] = 2;
+
+	//Safety (level 0) only comes from MSI or MSA
+	if ((l.eq4[1] == 0) || (l.eq4[2] == 0))
+		eq[3] = 0;
+	else if ((l.eq4[0] == 1) || (l.eq4[1] == 1) || (l.eq4[2] == 1))
+		eq[3] = 1;
+	else
+		eq[3] = 2;
+
+	eq[4] = l.e;
+
+	bool high = ((l.eq3eq6[3] == 0) && (vc == 0)) || ((l.eq3eq6[4] == 0) && (vi == 0)) || ((l.eq3eq6[5] == 0) && (va == 0));
+	eq[5] = high ? 0 : 1;
+}
+
+constexpr void CVSS_4_Engine::GetMacroVector(bool threat, bool environmental, int (&eq)[EQCount]) const
+{
+	GetEQs(GetLevels(threat, environmental), eq);
+}
+
+constexpr float CVSS_4_Engine::GetScore(bool threat, bool environmental, bool round) const
+{
+	Levels l = GetLevels(threat, environmental);
+
+	//no impact on either system scores 0 whatever the macro vector
+	if ((l.eq3eq6[0] == 2) && (l.eq3eq6[1] == 2) && (l.eq3eq6[2] == 2) && (l.eq4[0] == 3) && (l.eq4[1] == 3) && (l.eq4[2] == 3))
+		return 0;
+
+	int eq[EQCount] = {};
+	GetEQs(l, eq);
+	MacroVector const& macro = Macros.macros[GetMacroIndex(eq)];
+	const int distances[GroupCount] = {
+		GetDistance(EQ1Max[eq[0]], l.eq1),
+		GetDistance(EQ2Max[eq[1]], l.eq2),
+		GetDistance(EQ3EQ6Max[eq[2]][eq[5]], l.eq3eq6),
+		GetDistance(EQ4Max[eq[3]], l.eq4),
+		0
+	};
+	const int depths[GroupCount] = { EQ1Depth[eq[0]], EQ2Depth[eq[1]], EQ3EQ6Depth[eq[2]][eq[5]], EQ4Depth[eq[3]], 1 };
+
+	//each group with a lower macro vector moves the score towards it by the share of the group's depth the
+	//vector sits below the most severe vectors; the score drops by the mean of those moves
+	double drop = 0;
+	int lowers = 0;
+	for (size_t group = 0; group < GroupCount; group++)
+	{
+		if (macro.drop[group] == NoLowerMacro)
+			continue;
+		lowers++;
+		drop += macro.drop[group] * static_cast<double>(distances[group]) / depths[group];
+	}
+	double tenths = macro.score - ((lowers != 0) ? drop / lowers : 0);
+	tenths = std::min(std::max(tenths, 0.0), 100.0);
+	if (round)
+		tenths = static_cast<double>(static_cast<long>(tenths + 0.5 + 1e-5)); //half up, nudged past binary fractions just below .5
+	return static_cast<float>(tenths / 10.0);
+}
+
+//score a parsed 4.0 vector; usable in constant expressions
+constexpr ScoreResult ComputeScore(ParsedVector4 const& v)
+{
+	ScoreResult ret;
+	ret.version = CVSSVersion::V4_0;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	CVSS_4_Engine engine(v);
+	ret.base = engine.GetBaseScore();
+	ret.temporal = engine.GetTemporalScore();
+	ret.environmental = engine.GetEnvironmentalScore();
+	return ret;
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct ThreadPool::State
+{
+	//one task queue per thread; owners take from the front, thieves from the back
+	struct Queue
+	{
+		mutex lock;
+		deque<size_t> tasks;
+	};
+
+	unsigned threads;
+	unique_ptr<Queue[]> queues;
+	vector<thread> workers;
+
+	mutex lock;
+	condition_variable wake;
+	condition_variable done;
+	function<void(size_t)> const *task = nullptr;
+	size_t generation = 0;
+	atomic<size_t> remaining{0};
+	bool stop = false;
+
+	bool Next(size_t self, size_t &ret)
+	{
+		{
+			lock_guard<mutex> guard(queues[self].lock);
+			if (!queues[self].tasks.empty())
+			{
+				ret = queues[self].tasks.front();
+				queues[self].tasks.pop_front();
+				return true;
+			}
+		}
+		for (size_t k = 1; k < threads; k++)
+		{
+			Queue &victim = queues[(self + k) % threads];
+			lock_guard<mutex> guard(victim.lock);
+			if (!victim.tasks.empty())
+			{
+				ret = victim.tasks.back();
+				victim.tasks.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Drain(size_t self)
+	{
+		size_t current;
+		while (Next(self, current))
+		{
+			(*task)(current);
+			if (remaining.fetch_sub(1) == 1)
+			{
+				lock_guard<mutex> guard(lock);
+				done.notify_all();
+			}
+		}
+	}
+};
+
+ThreadPool::ThreadPool(unsigned threads) :
+	_state(new State)
+{
+	if (threads == 0)
+		threads = max(thread::hardware_concurrency(), 1u);
+	_state->threads = threads;
+	_state->queues.reset(new State::Queue[threads]);
+	for (unsigned k = 1; k < threads; k++)
+		_state->workers.emplace_back(&ThreadPool::Work, this, k);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> guard(_state->lock);
+		_state->stop = true;
+	}
+	_state->wake.notify_all();
+	for (auto &worker : _state->workers)
+		worker.join();
+}
+
+unsigned ThreadPool::GetThreads() const
+{
+	return _state->threads;
+}
+
+void ThreadPool::Work(size_t self)
+{
+	size_t seen = 0;
+	while (true)
+	{
+		{
+			unique_lock<mutex> guard(_state->lock);
+			_state->wake.wait(guard, [&] { return _state->stop || (_state->generation != seen); });
+			if (_state->stop)
+				return;
+			seen = _state->generation;
+		}
+		_state->Drain(self);
+	}
+}
+
+void ThreadPool::Run(size_t tasks, function<void(size_t)> const& task)
+{
+	if (tasks == 0)
+		return;
+	if (_state->threads == 1)
+	{
+		for (size_t k = 0; k < tasks; k++)
+			task(k);
+		return;
+	}
+
+	{
+		lock_guard<mutex> guard(_state->lock);
+		_state->task = &task;
+		_state->remaining = tasks;
+		//contiguous ranges keep neighbouring chunks on one thread until someone steals
+		for (size_t k = 0; k < _state->threads; k++)
+		{
+			lock_guard<mutex> queueGuard(_state->queues[k].lock);
+			for (size_t t = tasks * k / _state->threads; t < tasks * (k + 1) / _state->threads; t++)
+				_state->queues[k].tasks.push_back(t);
+		}
+		_state->generation++;
+	}
+	_state->wake.notify_all();
+
+	_state->Drain(0);
+	unique_lock<mutex> guard(_state->lock);
+	_state->done.wait(guard, [&] { return _state->remaining == 0; });
+	_state->task = nullptr;
+}
+
+void ScoreBatch(string_view const *vectors, size_t count, ScoreResult *results, ThreadPool &pool, ScoreCache *cache)
+{
+	size_t chunks = (count + BatchChunkSize - 1) / BatchChunkSize;
+	pool.Run(chunks, [&](size_t chunk) {
+		size_t end = min(count, (chunk + 1) * BatchChunkSize);
+		for (size_t n = chunk * BatchChunkSize; n < end; n++)
+			results[n] = cache ? cache->Score(vectors[n]) : Score(vectors[n]);
+	});
+}
+
+void ScoreBatch(string_view const *vectors, size_t count, ScoreResult *results, unsigned threads, ScoreCache *cache)
+{
+	ThreadPool pool(threads);
+	ScoreBatch(vectors, count, results, pool, cache);
+}
+
+void SummarizeBatch(string_view const *vectors, size_t count, ScoreSummary &summary, ThreadPool &pool, EnvironmentalProfile const *profile)
+{
+	size_t chunks = (count + BatchChunkSize - 1) / BatchChunkSize;
+	vector<ScoreSummary> summaries(chunks);
+	pool.Run(chunks, [&](size_t chunk) {
+		size_t end = min(count, (chunk + 1) * BatchChunkSize);
+		for (size_t n = chunk * BatchChunkSize; n < end; n++)
+		{
+			if (!vectors[n].empty())
+				Summarize(vectors[n], summaries[chunk], profile);
+		}
+	});
+	for (auto const& chunkSummary : summaries)
+		summary.Merge(chunkSummary);
+}
+
+void SummarizeBatch(string_view const *vectors, size_t count, ScoreSummary &summary, unsigned threads, EnvironmentalProfile const *profile)
+{
+	ThreadPool pool(threads);
+	SummarizeBatch(vectors, count, summary, pool, profile);
+}
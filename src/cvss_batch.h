@@ -0,0 +1,61 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_BATCH_H_
+#define HAVE_CVSS_BATCH_H_
+
+#include "cvss_cache.h"
+#include "cvss_score.h"
+#include "cvss_summary.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+//work-stealing thread pool; the thread calling Run() works as one of the threads, so a pool of 1 starts no threads
+class ThreadPool
+{
+	private:
+		struct State;
+		std::unique_ptr<State> _state;
+
+		void Work(size_t self);
+
+	public:
+		explicit ThreadPool(unsigned threads); //0 uses every hardware thread
+		~ThreadPool();
+		ThreadPool(ThreadPool const&) = delete;
+		ThreadPool &operator=(ThreadPool const&) = delete;
+
+		unsigned GetThreads() const;
+		void Run(size_t tasks, std::function<void(size_t)> const& task); //call task(0) .. task(tasks - 1) and wait for all of them
+};
+
+const size_t BatchChunkSize = 4096; //vectors scored per pool task
+
+//score count vectors into results[0 .. count - 1], in input order; a cache may be shared with other callers
+void ScoreBatch(std::string_view const *vectors, size_t count, ScoreResult *results, ThreadPool &pool, ScoreCache *cache = nullptr);
+void ScoreBatch(std::string_view const *vectors, size_t count, ScoreResult *results, unsigned threads = 0, ScoreCache *cache = nullptr);
+
+//add count vectors to summary; each pool task fills its own ScoreSummary, merged at the end
+void SummarizeBatch(std::string_view const *vectors, size_t count, ScoreSummary &summary, ThreadPool &pool, EnvironmentalProfile const *profile = nullptr);
+void SummarizeBatch(std::string_view const *vectors, size_t count, ScoreSummary &summary, unsigned threads = 0, EnvironmentalProfile const *profile = nullptr);
+
+#endif
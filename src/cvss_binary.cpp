@@ -0,0 +1,243 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_binary.h"
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+static const size_t BlockHeaderSize = 2 * sizeof(uint32_t);
+static const size_t RecordSize = sizeof(uint64_t) + 4; //packed vector plus four byte columns
+static_assert(sizeof(BinaryHeader) == 16, "BinaryHeader must match the file layout");
+
+static uint8_t GetTenths(float score)
+{
+	return static_cast<uint8_t>(lround(score * 10.0));
+}
+
+void AppendBinaryHeader(string &buffer)
+{
+	BinaryHeader header;
+	memcpy(header.magic, BinaryMagic, sizeof(header.magic));
+	header.version = BinaryFormatVersion;
+	header.headerSize = sizeof(BinaryHeader);
+	header.blockRecords = BinaryBlockRecords;
+	header.reserved = 0;
+	buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void BinaryBlockWriter::Add(PackedVector const& vector, ScoreResult const& result)
+{
+	_packed.push_back(vector.GetBits());
+	_base.push_back(GetTenths(result.base));
+	_temporal.push_back(GetTenths(result.temporal));
+	_environmental.push_back(GetTenths(result.environmental));
+	_severity.push_back(static_cast<uint8_t>(GetSeverity(result.base)));
+}
+
+void BinaryBlockWriter::AddUnpacked(ScoreResult const& result)
+{
+	_packed.push_back(BinaryUnpacked);
+	_base.push_back(GetTenths(result.base));
+	_temporal.push_back(GetTenths(result.temporal));
+	_environmental.push_back(GetTenths(result.environmental));
+	_severity.push_back(static_cast<uint8_t>(GetSeverity(result.base)));
+}
+
+void BinaryBlockWriter::AddUnscored()
+{
+	_packed.push_back(0);
+	_base.push_back(0);
+	_temporal.push_back(0);
+	_environmental.push_back(0);
+	_severity.push_back(BinaryUnscored);
+}
+
+size_t BinaryBlockWriter::GetCount() const
+{
+	return _packed.size();
+}
+
+void BinaryBlockWriter::AppendTo(string &buffer)
+{
+	uint32_t header[2] = {static_cast<uint32_t>(_packed.size()), 0};
+	buffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+	buffer.append(reinterpret_cast<const char*>(_packed.data()), _packed.size() * sizeof(uint64_t));
+	buffer.append(reinterpret_cast<const char*>(_base.data()), _base.size());
+	buffer.append(reinterpret_cast<const char*>(_temporal.data()), _temporal.size());
+	buffer.append(reinterpret_cast<const char*>(_environmental.data()), _environmental.size());
+	buffer.append(reinterpret_cast<const char*>(_severity.data()), _severity.size());
+
+	_packed.clear();
+	_base.clear();
+	_temporal.clear();
+	_environmental.clear();
+	_severity.clear();
+}
+
+ScoreFile::ScoreFile() :
+	_headerSize(0),
+	_blockRecords(0),
+	_blockSize(0),
+	_blocks(0),
+	_count(0)
+{
+}
+
+bool ScoreFile::Open(string const& path)
+{
+	Close();
+	if (!_file.Open(path))
+		return false;
+	if (!Load(_file.GetData()))
+	{
+		_file.Close();
+		return false;
+	}
+	return true;
+}
+
+bool ScoreFile::Load(string_view data)
+{
+	_data = string_view();
+	_headerSize = _blockRecords = _blockSize = _blocks = _count = 0;
+
+	BinaryHeader header;
+	if (data.size() < sizeof(header))
+		return false;
+	memcpy(&header, data.data(), sizeof(header));
+	if ((memcmp(header.magic, BinaryMagic, sizeof(header.magic)) != 0) || (header.version != BinaryFormatVersion) || (header.headerSize < sizeof(header)) || (header.headerSize > data.size()) || (header.headerSize % sizeof(uint64_t) != 0) || (header.blockRecords == 0))
+		return false;
+
+	//every block is full except perhaps the last, so the size alone fixes the layout
+	size_t blockRecords = header.blockRecords;
+	size_t blockSize = BlockHeaderSize + blockRecords * RecordSize;
+	size_t body = data.size() - header.headerSize;
+	size_t blocks = body / blockSize;
+	size_t count = blocks * blockRecords;
+	size_t last = body % blockSize;
+	if (last != 0)
+	{
+		if ((last <= BlockHeaderSize) || ((last - BlockHeaderSize) % RecordSize != 0))
+			return false;
+		blocks++;
+		count += (last - BlockHeaderSize) / RecordSize;
+	}
+
+	//block counts must agree with the layout; the packed column must be aligned for direct access
+	_data = data;
+	_headerSize = header.headerSize;
+	_blockRecords = blockRecords;
+	_blockSize = blockSize;
+	_blocks = blocks;
+	_count = count;
+	for (size_t block = 0; block < blocks; block++)
+	{
+		uint32_t stored;
+		memcpy(&stored, data.data() + GetBlockOffset(block), sizeof(stored));
+		size_t expected = (block + 1 < blocks) ? blockRecords : count - block * blockRecords;
+		if ((stored != expected) || (reinterpret_cast<uintptr_t>(data.data() + GetBlockOffset(block) + BlockHeaderSize) % alignof(uint64_t) != 0))
+		{
+			_data = string_view();
+			_headerSize = _blockRecords = _blockSize = _blocks = _count = 0;
+			return false;
+		}
+	}
+	return true;
+}
+
+void ScoreFile::Close()
+{
+	_file.Close();
+	_data = string_view();
+	_headerSize = _blockRecords = _blockSize = _blocks = _count = 0;
+}
+
+size_t ScoreFile::GetBlockOffset(size_t block) const
+{
+	return _headerSize + block * _blockSize;
+}
+
+size_t ScoreFile::GetCount() const
+{
+	return _count;
+}
+
+size_t ScoreFile::GetBlockCount() const
+{
+	return _blocks;
+}
+
+BinaryBlock ScoreFile::GetBlock(size_t block) const
+{
+	BinaryBlock ret;
+	if (block >= _blocks)
+		return ret;
+	const char *start = _data.data() + GetBlockOffset(block);
+	ret.count = (block + 1 < _blocks) ? _blockRecords : _count - block * _blockRecords;
+	ret.packed = reinterpret_cast<const uint64_t*>(start + BlockHeaderSize);
+	ret.base = reinterpret_cast<const uint8_t*>(start + BlockHeaderSize + ret.count * sizeof(uint64_t));
+	ret.temporal = ret.base + ret.count;
+	ret.environmental = ret.temporal + ret.count;
+	ret.severity = ret.environmental + ret.count;
+	return ret;
+}
+
+bool ScoreFile::IsScored(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return block.severity[n % _blockRecords] != BinaryUnscored;
+}
+
+bool ScoreFile::IsPacked(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return (block.severity[n % _blockRecords] != BinaryUnscored) && (block.packed[n % _blockRecords] != BinaryUnpacked);
+}
+
+PackedVector ScoreFile::GetVector(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return PackedVector(block.packed[n % _blockRecords]);
+}
+
+float ScoreFile::GetBaseScore(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return block.base[n % _blockRecords] / 10.0f;
+}
+
+float ScoreFile::GetTemporalScore(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return block.temporal[n % _blockRecords] / 10.0f;
+}
+
+float ScoreFile::GetEnvironmentalScore(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	return block.environmental[n % _blockRecords] / 10.0f;
+}
+
+Severity ScoreFile::GetSeverity(size_t n) const
+{
+	BinaryBlock block = GetBlock(n / _blockRecords);
+	uint8_t severity = block.severity[n % _blockRecords];
+	return (severity <= static_cast<uint8_t>(Severity::Critical)) ? static_cast<Severity>(severity) : Severity::None;
+}
@@ -0,0 +1,125 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_BINARY_H_
+#define HAVE_CVSS_BINARY_H_
+
+#include "cvss_mmap.h"
+#include "cvss_packed.h"
+#include "cvss_score.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//binary batch output: a BinaryHeader followed by column blocks, in host byte order
+//every block but the last holds BinaryBlockRecords records; a block is
+//  uint32_t count, uint32_t reserved
+//  uint64_t packed[count]           PackedVector bits (0 for an unscored line, BinaryUnpacked for a 2.0 or 4.0 vector)
+//  uint8_t base[count]              Base Score in tenths
+//  uint8_t temporal[count]          Temporal Score in tenths
+//  uint8_t environmental[count]     Environmental Score in tenths
+//  uint8_t severity[count]          Severity of the Base Score, or BinaryUnscored
+const char BinaryMagic[4] = {'C', 'V', 'S', 'B'};
+const uint16_t BinaryFormatVersion = 1; //a reader on the other byte order sees 0x0100 and refuses the file
+const size_t BinaryBlockRecords = 4096;
+const uint8_t BinaryUnscored = 0xFF; //severity of a blank or invalid input line
+const uint64_t BinaryUnpacked = ~uint64_t(0); //packed bits of a scored vector PackedVector cannot hold (CVSS 2.0 and 4.0)
+
+struct BinaryHeader
+{
+	char magic[4];
+	uint16_t version;
+	uint16_t headerSize; //sizeof(BinaryHeader); later versions may append fields
+	uint32_t blockRecords;
+	uint32_t reserved;
+};
+
+void AppendBinaryHeader(std::string &buffer);
+
+//collects up to BinaryBlockRecords records, then appends them to a buffer as one block
+//only the last block of a file may hold fewer than BinaryBlockRecords
+class BinaryBlockWriter
+{
+	private:
+		std::vector<uint64_t> _packed;
+		std::vector<uint8_t> _base;
+		std::vector<uint8_t> _temporal;
+		std::vector<uint8_t> _environmental;
+		std::vector<uint8_t> _severity;
+
+	public:
+		void Add(PackedVector const& vector, ScoreResult const& result);
+		void AddUnpacked(ScoreResult const& result); //scored, with BinaryUnpacked for the vector
+		void AddUnscored();
+		size_t GetCount() const;
+		void AppendTo(std::string &buffer); //appends the block, then starts a new one
+};
+
+//columns of one block; the pointers view the file's memory
+struct BinaryBlock
+{
+	size_t count = 0;
+	const uint64_t *packed = nullptr;
+	const uint8_t *base = nullptr;
+	const uint8_t *temporal = nullptr;
+	const uint8_t *environmental = nullptr;
+	const uint8_t *severity = nullptr;
+};
+
+//zero-copy reader for binary batch output
+class ScoreFile
+{
+	private:
+		MappedFile _file;
+		std::string_view _data;
+		size_t _headerSize;
+		size_t _blockRecords;
+		size_t _blockSize;
+		size_t _blocks;
+		size_t _count;
+
+		size_t GetBlockOffset(size_t block) const;
+
+	public:
+		ScoreFile();
+		ScoreFile(ScoreFile const&) = delete;
+		ScoreFile &operator=(ScoreFile const&) = delete;
+
+		bool Open(std::string const& path); //maps the file; false if it cannot be mapped or is not valid binary output
+		bool Load(std::string_view data); //same, over data the caller keeps alive
+		void Close();
+
+		size_t GetCount() const; //records, one per input line
+		size_t GetBlockCount() const;
+		BinaryBlock GetBlock(size_t block) const;
+
+		//random access to record n, which must be below GetCount()
+		bool IsScored(size_t n) const;
+		bool IsPacked(size_t n) const; //scored with its vector; GetVector() is only meaningful then
+		PackedVector GetVector(size_t n) const;
+		float GetBaseScore(size_t n) const; //Base Score
+		float GetTemporalScore(size_t n) const; //Temporal Score
+		float GetEnvironmentalScore(size_t n) const; //Environmental Score
+		Severity GetSeverity(size_t n) const; //Severity::None for unscored records
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_cache.h"
+#include "cvss_profile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+	size_t RoundUpPowerOfTwo(size_t value)
+	{
+		size_t ret = 1;
+		while (ret < value)
+			ret <<= 1;
+		return ret;
+	}
+
+	size_t RoundDownPowerOfTwo(size_t value)
+	{
+		size_t ret = 1;
+		while (ret <= value / 2)
+			ret <<= 1;
+		return ret;
+	}
+}
+
+//shards sit on their own cache lines so threads hitting different shards do not share counters
+struct alignas(64) ScoreCache::Shard
+{
+	struct Slot
+	{
+		string key; //empty when unused; assign() reuses its buffer when the slot is replaced
+		ScoreResult result;
+	};
+
+	mutable mutex lock;
+	vector<Slot> slots;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+};
+
+ScoreCache::ScoreCache(size_t capacity, unsigned shards, EnvironmentalProfile const *profile) :
+	_profile(profile)
+{
+	if (shards == 0)
+		shards = max(thread::hardware_concurrency(), 1u) * 4;
+	//capacity is the bound: small caches get fewer shards, and the slots are split evenly rather than rounded up
+	capacity = max<size_t>(capacity, 1);
+	_shardCount = min(RoundUpPowerOfTwo(shards), RoundDownPowerOfTwo(capacity));
+	_slotsPerShard = min<size_t>(capacity / _shardCount, UINT32_MAX);
+	_shards.reset(new Shard[_shardCount]);
+	for (size_t k = 0; k < _shardCount; k++)
+		_shards[k].slots.resize(_slotsPerShard);
+}
+
+ScoreCache::~ScoreCache()
+{
+}
+
+ScoreResult ScoreCache::Score(string_view data)
+{
+	if (data.empty())
+		return _profile ? _profile->Score(data) : ::Score(data);
+
+	//low bits pick the shard, and the top 32 bits are scaled onto the slots within it, which need not be a power of two
+	size_t key = hash<string_view>()(data);
+	Shard &shard = _shards[key & (_shardCount - 1)];
+	uint32_t high = static_cast<uint32_t>(key >> (numeric_limits<size_t>::digits - 32));
+	Shard::Slot &slot = shard.slots[static_cast<size_t>((static_cast<uint64_t>(high) * _slotsPerShard) >> 32)];
+	{
+		lock_guard<mutex> guard(shard.lock);
+		if (slot.key == data)
+		{
+			shard.hits++;
+			return slot.result;
+		}
+		shard.misses++;
+	}
+
+	//score outside the lock so a miss never holds up the shard
+	ScoreResult ret = _profile ? _profile->Score(data) : ::Score(data);
+	lock_guard<mutex> guard(shard.lock);
+	slot.key.assign(data.data(), data.size());
+	slot.result = ret;
+	return ret;
+}
+
+void ScoreCache::Clear()
+{
+	for (size_t k = 0; k < _shardCount; k++)
+	{
+		lock_guard<mutex> guard(_shards[k].lock);
+		for (auto &slot : _shards[k].slots)
+			slot.key.clear();
+		_shards[k].hits = 0;
+		_shards[k].misses = 0;
+	}
+}
+
+size_t ScoreCache::GetCapacity() const
+{
+	return _shardCount * _slotsPerShard;
+}
+
+uint64_t ScoreCache::GetHits() const
+{
+	uint64_t ret = 0;
+	for (size_t k = 0; k < _shardCount; k++)
+	{
+		lock_guard<mutex> guard(_shards[k].lock);
+		ret += _shards[k].hits;
+	}
+	return ret;
+}
+
+uint64_t ScoreCache::GetMisses() const
+{
+	uint64_t ret = 0;
+	for (size_t k = 0; k < _shardCount; k++)
+	{
+		lock_guard<mutex> guard(_shards[k].lock);
+		ret += _shards[k].misses;
+	}
+	return ret;
+}
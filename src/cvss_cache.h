@@ -0,0 +1,59 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_CACHE_H_
+#define HAVE_CVSS_CACHE_H_
+
+#include "cvss_score.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+class EnvironmentalProfile;
+
+const size_t DefaultScoreCacheSize = 65536; //entries; comfortably more than the distinct vectors in a typical feed
+
+//bounded, thread-safe memo of Score() keyed on the vector text, so repeated vectors skip parsing entirely;
+//entries are spread over independently locked shards and a colliding vector replaces the entry it lands on
+class ScoreCache
+{
+	private:
+		struct Shard;
+		std::unique_ptr<Shard[]> _shards;
+		size_t _shardCount;
+		size_t _slotsPerShard;
+		EnvironmentalProfile const *_profile;
+
+	public:
+		explicit ScoreCache(size_t capacity = DefaultScoreCacheSize, unsigned shards = 0, EnvironmentalProfile const *profile = nullptr); //0 shards picks 4 per hardware thread; shards are rounded up to a power of two no larger than capacity, and GetCapacity() never exceeds capacity
+		~ScoreCache();
+		ScoreCache(ScoreCache const&) = delete;
+		ScoreCache &operator=(ScoreCache const&) = delete;
+
+		ScoreResult Score(std::string_view data); //same result as ::Score(data), or the profile's Score(data) if the cache has one
+		void Clear(); //drops every entry and resets the counters
+
+		size_t GetCapacity() const;
+		uint64_t GetHits() const;
+		uint64_t GetMisses() const;
+};
+
+#endif
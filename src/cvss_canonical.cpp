@@ -0,0 +1,138 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_canonical.h"
+
+using namespace std;
+
+namespace
+{
+	//value letters in the order of each enum, as in the parser's grammar
+	const char AttackVectorLetters[] = "NALP";
+	const char AttackComplexityLetters[] = "LH";
+	const char PrivilegesRequiredLetters[] = "NLH";
+	const char UserInteractionLetters[] = "NR";
+	const char ScopeLetters[] = "UC";
+	const char ImpactLetters[] = "HLN";
+	const char ExploitCodeMaturityLetters[] = "XHFPU";
+	const char RemediationLevelLetters[] = "XUWTO";
+	const char ReportConfidenceLetters[] = "XCRU";
+	const char RequirementLetters[] = "XHML";
+
+	template<typename T> void AppendMetric(string &ret, const char *key, const char *letters, T value)
+	{
+		ret += '/';
+		ret += key;
+		ret += ':';
+		ret += letters[static_cast<size_t>(value)];
+	}
+
+	//Not Defined is the first value of every optional metric
+	template<typename T> void AppendDefined(string &ret, const char *key, const char *letters, T value)
+	{
+		if (static_cast<size_t>(value) != 0)
+			AppendMetric(ret, key, letters, value);
+	}
+
+	template<typename T> void AppendModified(string &ret, const char *key, const char *letters, Modified<T> const& value)
+	{
+		if (value.modified)
+			AppendMetric(ret, key, letters, value.parent);
+	}
+}
+
+ParsedVector Canonicalize(ParsedVector const& vector)
+{
+	ParsedVector ret = vector;
+	ret.error = ParseError::None;
+	ret.errorOffset = 0;
+	ret.errorLength = 0;
+	return ret;
+}
+
+PackedVector GetCanonicalKey(ParsedVector const& vector)
+{
+	return PackedVector(Canonicalize(vector));
+}
+
+string FormatVector(ParsedVector const& v)
+{
+	string ret = (v.version == CVSSVersion::V3_0) ? "CVSS:3.0" : "CVSS:3.1";
+	AppendMetric(ret, "AV", AttackVectorLetters, v.av);
+	AppendMetric(ret, "AC", AttackComplexityLetters, v.ac);
+	AppendMetric(ret, "PR", PrivilegesRequiredLetters, v.pr);
+	AppendMetric(ret, "UI", UserInteractionLetters, v.ui);
+	AppendMetric(ret, "S", ScopeLetters, v.s);
+	AppendMetric(ret, "C", ImpactLetters, v.c);
+	AppendMetric(ret, "I", ImpactLetters, v.i);
+	AppendMetric(ret, "A", ImpactLetters, v.a);
+	AppendDefined(ret, "E", ExploitCodeMaturityLetters, v.e);
+	AppendDefined(ret, "RL", RemediationLevelLetters, v.rl);
+	AppendDefined(ret, "RC", ReportConfidenceLetters, v.rc);
+	AppendDefined(ret, "CR", RequirementLetters, v.cr);
+	AppendDefined(ret, "IR", RequirementLetters, v.ir);
+	AppendDefined(ret, "AR", RequirementLetters, v.ar);
+	AppendModified(ret, "MAV", AttackVectorLetters, v.mav);
+	AppendModified(ret, "MAC", AttackComplexityLetters, v.mac);
+	AppendModified(ret, "MPR", PrivilegesRequiredLetters, v.mpr);
+	AppendModified(ret, "MUI", UserInteractionLetters, v.mui);
+	AppendModified(ret, "MS", ScopeLetters, v.ms);
+	AppendModified(ret, "MC", ImpactLetters, v.mc);
+	AppendModified(ret, "MI", ImpactLetters, v.mi);
+	AppendModified(ret, "MA", ImpactLetters, v.ma);
+	return ret;
+}
+
+size_t DistinctVectors::Count(size_t id, bool inserted)
+{
+	if (inserted)
+		_counts.push_back(0);
+	_counts[id]++;
+	return id;
+}
+
+size_t DistinctVectors::Add(PackedVector key)
+{
+	auto found = _keys.emplace(key.GetBits(), _vectors.size());
+	if (found.second)
+		_vectors.push_back(FormatVector(key.Unpack()));
+	return Count(found.first->second, found.second);
+}
+
+size_t DistinctVectors::Add(string_view vector)
+{
+	auto found = _texts.emplace(string(vector), _vectors.size());
+	if (found.second)
+		_vectors.emplace_back(vector);
+	return Count(found.first->second, found.second);
+}
+
+size_t DistinctVectors::GetCount() const
+{
+	return _vectors.size();
+}
+
+string const& DistinctVectors::GetVector(size_t id) const
+{
+	return _vectors[id];
+}
+
+uint64_t DistinctVectors::GetOccurrences(size_t id) const
+{
+	return _counts[id];
+}
@@ -0,0 +1,60 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_CANONICAL_H_
+#define HAVE_CVSS_CANONICAL_H_
+
+#include "cvss_packed.h"
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//one spelling per logical 3.x vector: the metrics in specification order, every base metric present, and
+//Not Defined ("X") metrics left out; vectors that parse to the same metrics get the same string and key
+ParsedVector Canonicalize(ParsedVector const& vector); //the vector without its error fields; the parser already resets metrics set to X
+PackedVector GetCanonicalKey(ParsedVector const& vector); //PackedVector of Canonicalize(vector)
+std::string FormatVector(ParsedVector const& vector); //e.g. "CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H/E:P"
+
+//distinct vectors of a stream, numbered from 0 in the order they are first seen, with their occurrences; 3.x
+//vectors are told apart by canonical key, 2.0 and 4.0 vectors by their text
+class DistinctVectors
+{
+	private:
+		std::unordered_map<uint64_t, size_t> _keys;
+		std::unordered_map<std::string, size_t> _texts;
+		std::vector<std::string> _vectors; //canonical string of each distinct vector
+		std::vector<uint64_t> _counts;
+
+		size_t Count(size_t id, bool inserted); //one more occurrence of id, which is new if inserted
+
+	public:
+		size_t Add(PackedVector key); //id of the key's vector, adding it if new
+		size_t Add(std::string_view vector); //same for a 2.0 or 4.0 vector, by its text
+
+		size_t GetCount() const; //distinct vectors
+		std::string const& GetVector(size_t id) const;
+		uint64_t GetOccurrences(size_t id) const;
+};
+
+#endif
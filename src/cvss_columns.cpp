@@ -0,0 +1,360 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_columns.h"
+#include "cvss_table.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CVSS_X86_KERNELS
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__ARM_NEON))
+#define CVSS_ARM_KERNELS
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+	const int RequirementHigh = static_cast<int>(Requirement::High);
+	const int RequirementLow = static_cast<int>(Requirement::Low);
+	const int DefaultVersion = static_cast<int>(CVSSVersion::V3_1);
+	static_assert((static_cast<int>(CVSSVersion::V3_0) == 0) && (DefaultVersion == 1) && (VersionTableSize == 2), "the environmental table's version rows are clamped with min(version, DefaultVersion)");
+
+	//the table pointers one ScoreColumns() call needs
+	struct Tables
+	{
+		const float *tenths;
+		const uint8_t *base;
+		const uint8_t *temporal;
+		const uint8_t *environmental;
+
+		Tables(bool needBase, bool needTemporal, bool needEnvironmental) :
+			tenths(GetTenthsTable()),
+			base(needBase ? GetBaseTable() : nullptr),
+			temporal(needTemporal ? GetTemporalTable() : nullptr),
+			environmental(needEnvironmental ? GetEnvironmentalTable() : nullptr)
+		{
+		}
+	};
+
+	//same packing as GetBaseIndex()
+	inline uint32_t PackBaseIndex(uint32_t av, uint32_t ac, uint32_t pr, uint32_t ui, uint32_t s, uint32_t c, uint32_t i, uint32_t a)
+	{
+		return ((((((av * 2 + ac) * 3 + pr) * 2 + ui) * 2 + s) * 3 + c) * 3 + i) * 3 + a;
+	}
+
+	inline uint32_t Effective(uint8_t base, uint8_t modified)
+	{
+		return (modified == MetricNotDefined) ? base : modified;
+	}
+
+	//the environmental table only has 3.0 and 3.1 rows, so every other version scores as 3.1 rather than reading past them
+	inline uint32_t Version(MetricColumns const& m, size_t n)
+	{
+		return m.version ? min<uint32_t>(m.version[n], DefaultVersion) : DefaultVersion;
+	}
+
+	//same weights as GetRequirementIndex(): Low, Medium (or Not Defined), High
+	inline uint32_t Weight(uint8_t r)
+	{
+		return (r == RequirementLow) ? 0 : ((r == RequirementHigh) ? 2 : 1);
+	}
+
+	void ScoreColumnsScalar(MetricColumns const& m, size_t begin, Tables const& t, float *base, float *temporal, float *environmental)
+	{
+		for (size_t n = begin; n < m.count; n++)
+		{
+			if (base || temporal)
+			{
+				uint32_t b = PackBaseIndex(m.av[n], m.ac[n], m.pr[n], m.ui[n], m.s[n], m.c[n], m.i[n], m.a[n]);
+				if (base)
+					base[n] = t.tenths[t.base[b]];
+				if (temporal)
+					temporal[n] = t.tenths[t.temporal[b * TemporalTableSize + (m.e[n] * 5 + m.rl[n]) * 4 + m.rc[n]]];
+			}
+			if (environmental)
+			{
+				uint32_t b = PackBaseIndex(Effective(m.av[n], m.mav[n]), Effective(m.ac[n], m.mac[n]), Effective(m.pr[n], m.mpr[n]), Effective(m.ui[n], m.mui[n]), Effective(m.s[n], m.ms[n]), Effective(m.c[n], m.mc[n]), Effective(m.i[n], m.mi[n]), Effective(m.a[n], m.ma[n]));
+				uint32_t r = (Weight(m.cr[n]) * 3 + Weight(m.ir[n])) * 3 + Weight(m.ar[n]);
+				environmental[n] = t.tenths[t.environmental[(Version(m, n) * BaseTableSize + b) * RequirementTableSize + r]];
+			}
+		}
+	}
+
+#ifdef CVSS_X86_KERNELS
+	//SSE2: indices are built eight at a time in 16-bit lanes, then looked up one by one
+	__attribute__((target("sse2"))) inline __m128i Load16(const uint8_t *column, size_t n)
+	{
+		return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(column + n)), _mm_setzero_si128());
+	}
+
+	__attribute__((target("sse2"))) inline __m128i MulAdd16(__m128i acc, short factor, __m128i x)
+	{
+		return _mm_add_epi16(_mm_mullo_epi16(acc, _mm_set1_epi16(factor)), x);
+	}
+
+	__attribute__((target("sse2"))) inline __m128i Effective16(__m128i base, __m128i modified)
+	{
+		__m128i notDefined = _mm_cmpeq_epi16(modified, _mm_set1_epi16(MetricNotDefined));
+		return _mm_or_si128(_mm_and_si128(notDefined, base), _mm_andnot_si128(notDefined, modified));
+	}
+
+	__attribute__((target("sse2"))) inline __m128i Weight16(__m128i r)
+	{
+		//comparisons yield -1, so this is 1 + (r == High) - (r == Low)
+		return _mm_add_epi16(_mm_sub_epi16(_mm_set1_epi16(1), _mm_cmpeq_epi16(r, _mm_set1_epi16(RequirementHigh))), _mm_cmpeq_epi16(r, _mm_set1_epi16(RequirementLow)));
+	}
+
+	__attribute__((target("sse2"))) inline __m128i BaseIndex16(__m128i av, __m128i ac, __m128i pr, __m128i ui, __m128i s, __m128i c, __m128i i, __m128i a)
+	{
+		return MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(av, 2, ac), 3, pr), 2, ui), 2, s), 3, c), 3, i), 3, a);
+	}
+
+	__attribute__((target("sse2"))) size_t ScoreColumnsSSE2(MetricColumns const& m, Tables const& t, float *base, float *temporal, float *environmental)
+	{
+		alignas(16) uint16_t first[8];
+		alignas(16) uint16_t second[8];
+		size_t n = 0;
+		for (; n + 8 <= m.count; n += 8)
+		{
+			if (base || temporal)
+			{
+				__m128i b = BaseIndex16(Load16(m.av, n), Load16(m.ac, n), Load16(m.pr, n), Load16(m.ui, n), Load16(m.s, n), Load16(m.c, n), Load16(m.i, n), Load16(m.a, n));
+				_mm_store_si128(reinterpret_cast<__m128i*>(first), b);
+				if (base)
+				{
+					for (size_t k = 0; k < 8; k++)
+						base[n + k] = t.tenths[t.base[first[k]]];
+				}
+				if (temporal)
+				{
+					_mm_store_si128(reinterpret_cast<__m128i*>(second), MulAdd16(MulAdd16(Load16(m.e, n), 5, Load16(m.rl, n)), 4, Load16(m.rc, n)));
+					for (size_t k = 0; k < 8; k++)
+						temporal[n + k] = t.tenths[t.temporal[first[k] * TemporalTableSize + second[k]]];
+				}
+			}
+			if (environmental)
+			{
+				__m128i b = BaseIndex16(Effective16(Load16(m.av, n), Load16(m.mav, n)), Effective16(Load16(m.ac, n), Load16(m.mac, n)), Effective16(Load16(m.pr, n), Load16(m.mpr, n)), Effective16(Load16(m.ui, n), Load16(m.mui, n)), Effective16(Load16(m.s, n), Load16(m.ms, n)), Effective16(Load16(m.c, n), Load16(m.mc, n)), Effective16(Load16(m.i, n), Load16(m.mi, n)), Effective16(Load16(m.a, n), Load16(m.ma, n)));
+				__m128i r = MulAdd16(MulAdd16(Weight16(Load16(m.cr, n)), 3, Weight16(Load16(m.ir, n))), 3, Weight16(Load16(m.ar, n)));
+				_mm_store_si128(reinterpret_cast<__m128i*>(first), b);
+				_mm_store_si128(reinterpret_cast<__m128i*>(second), r);
+				for (size_t k = 0; k < 8; k++)
+					environmental[n + k] = t.tenths[t.environmental[(Version(m, n + k) * BaseTableSize + first[k]) * RequirementTableSize + second[k]]];
+			}
+		}
+		return n;
+	}
+
+	//AVX2: indices are built eight at a time in 32-bit lanes and both table lookups are gathers
+	__attribute__((target("avx2"))) inline __m256i Load32(const uint8_t *column, size_t n)
+	{
+		return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(column + n)));
+	}
+
+	__attribute__((target("avx2"))) inline __m256i MulAdd32(__m256i acc, int factor, __m256i x)
+	{
+		return _mm256_add_epi32(_mm256_mullo_epi32(acc, _mm256_set1_epi32(factor)), x);
+	}
+
+	__attribute__((target("avx2"))) inline __m256i Effective32(__m256i base, __m256i modified)
+	{
+		return _mm256_blendv_epi8(modified, base, _mm256_cmpeq_epi32(modified, _mm256_set1_epi32(MetricNotDefined)));
+	}
+
+	__attribute__((target("avx2"))) inline __m256i Weight32(__m256i r)
+	{
+		return _mm256_add_epi32(_mm256_sub_epi32(_mm256_set1_epi32(1), _mm256_cmpeq_epi32(r, _mm256_set1_epi32(RequirementHigh))), _mm256_cmpeq_epi32(r, _mm256_set1_epi32(RequirementLow)));
+	}
+
+	__attribute__((target("avx2"))) inline __m256i BaseIndex32(__m256i av, __m256i ac, __m256i pr, __m256i ui, __m256i s, __m256i c, __m256i i, __m256i a)
+	{
+		return MulAdd32(MulAdd32(MulAdd32(MulAdd32(MulAdd32(MulAdd32(MulAdd32(av, 2, ac), 3, pr), 2, ui), 2, s), 3, c), 3, i), 3, a);
+	}
+
+	//tables hold one byte per score; gather a 32-bit word (hence the table padding) and keep the low byte
+	__attribute__((target("avx2"))) inline __m256 Lookup32(const uint8_t *table, __m256i index, const float *tenths)
+	{
+		__m256i score = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 1), _mm256_set1_epi32(0xFF));
+		return _mm256_i32gather_ps(tenths, score, 4);
+	}
+
+	__attribute__((target("avx2"))) size_t ScoreColumnsAVX2(MetricColumns const& m, Tables const& t, float *base, float *temporal, float *environmental)
+	{
+		size_t n = 0;
+		for (; n + 8 <= m.count; n += 8)
+		{
+			if (base || temporal)
+			{
+				__m256i b = BaseIndex32(Load32(m.av, n), Load32(m.ac, n), Load32(m.pr, n), Load32(m.ui, n), Load32(m.s, n), Load32(m.c, n), Load32(m.i, n), Load32(m.a, n));
+				if (base)
+					_mm256_storeu_ps(base + n, Lookup32(t.base, b, t.tenths));
+				if (temporal)
+				{
+					__m256i tmpTemporal = MulAdd32(MulAdd32(Load32(m.e, n), 5, Load32(m.rl, n)), 4, Load32(m.rc, n));
+					_mm256_storeu_ps(temporal + n, Lookup32(t.temporal, MulAdd32(b, TemporalTableSize, tmpTemporal), t.tenths));
+				}
+			}
+			if (environmental)
+			{
+				__m256i b = BaseIndex32(Effective32(Load32(m.av, n), Load32(m.mav, n)), Effective32(Load32(m.ac, n), Load32(m.mac, n)), Effective32(Load32(m.pr, n), Load32(m.mpr, n)), Effective32(Load32(m.ui, n), Load32(m.mui, n)), Effective32(Load32(m.s, n), Load32(m.ms, n)), Effective32(Load32(m.c, n), Load32(m.mc, n)), Effective32(Load32(m.i, n), Load32(m.mi, n)), Effective32(Load32(m.a, n), Load32(m.ma, n)));
+				__m256i r = MulAdd32(MulAdd32(Weight32(Load32(m.cr, n)), 3, Weight32(Load32(m.ir, n))), 3, Weight32(Load32(m.ar, n)));
+				__m256i version = m.version ? _mm256_min_epu32(Load32(m.version, n), _mm256_set1_epi32(DefaultVersion)) : _mm256_set1_epi32(DefaultVersion); //see Version()
+				_mm256_storeu_ps(environmental + n, Lookup32(t.environmental, MulAdd32(MulAdd32(version, BaseTableSize, b), RequirementTableSize, r), t.tenths));
+			}
+		}
+		return n;
+	}
+#endif
+
+#ifdef CVSS_ARM_KERNELS
+	//NEON: indices are built eight at a time in 16-bit lanes, as in the SSE2 kernel, then looked up one by one since there is no gather
+	inline uint16x8_t Load16(const uint8_t *column, size_t n)
+	{
+		return vmovl_u8(vld1_u8(column + n));
+	}
+
+	inline uint16x8_t MulAdd16(uint16x8_t acc, uint16_t factor, uint16x8_t x)
+	{
+		return vmlaq_n_u16(x, acc, factor);
+	}
+
+	inline uint16x8_t Effective16(uint16x8_t base, uint16x8_t modified)
+	{
+		return vbslq_u16(vceqq_u16(modified, vdupq_n_u16(MetricNotDefined)), base, modified);
+	}
+
+	inline uint16x8_t Weight16(uint16x8_t r)
+	{
+		//comparisons yield all ones, so this is 1 + (r == High) - (r == Low) modulo 2^16
+		return vaddq_u16(vsubq_u16(vdupq_n_u16(1), vceqq_u16(r, vdupq_n_u16(RequirementHigh))), vceqq_u16(r, vdupq_n_u16(RequirementLow)));
+	}
+
+	inline uint16x8_t BaseIndex16(uint16x8_t av, uint16x8_t ac, uint16x8_t pr, uint16x8_t ui, uint16x8_t s, uint16x8_t c, uint16x8_t i, uint16x8_t a)
+	{
+		return MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(MulAdd16(av, 2, ac), 3, pr), 2, ui), 2, s), 3, c), 3, i), 3, a);
+	}
+
+	size_t ScoreColumnsNEON(MetricColumns const& m, Tables const& t, float *base, float *temporal, float *environmental)
+	{
+		uint16_t first[8];
+		uint16_t second[8];
+		size_t n = 0;
+		for (; n + 8 <= m.count; n += 8)
+		{
+			if (base || temporal)
+			{
+				vst1q_u16(first, BaseIndex16(Load16(m.av, n), Load16(m.ac, n), Load16(m.pr, n), Load16(m.ui, n), Load16(m.s, n), Load16(m.c, n), Load16(m.i, n), Load16(m.a, n)));
+				if (base)
+				{
+					for (size_t k = 0; k < 8; k++)
+						base[n + k] = t.tenths[t.base[first[k]]];
+				}
+				if (temporal)
+				{
+					vst1q_u16(second, MulAdd16(MulAdd16(Load16(m.e, n), 5, Load16(m.rl, n)), 4, Load16(m.rc, n)));
+					for (size_t k = 0; k < 8; k++)
+						temporal[n + k] = t.tenths[t.temporal[first[k] * TemporalTableSize + second[k]]];
+				}
+			}
+			if (environmental)
+			{
+				vst1q_u16(first, BaseIndex16(Effective16(Load16(m.av, n), Load16(m.mav, n)), Effective16(Load16(m.ac, n), Load16(m.mac, n)), Effective16(Load16(m.pr, n), Load16(m.mpr, n)), Effective16(Load16(m.ui, n), Load16(m.mui, n)), Effective16(Load16(m.s, n), Load16(m.ms, n)), Effective16(Load16(m.c, n), Load16(m.mc, n)), Effective16(Load16(m.i, n), Load16(m.mi, n)), Effective16(Load16(m.a, n), Load16(m.ma, n))));
+				vst1q_u16(second, MulAdd16(MulAdd16(Weight16(Load16(m.cr, n)), 3, Weight16(Load16(m.ir, n))), 3, Weight16(Load16(m.ar, n))));
+				for (size_t k = 0; k < 8; k++)
+					environmental[n + k] = t.tenths[t.environmental[(Version(m, n + k) * BaseTableSize + first[k]) * RequirementTableSize + second[k]]];
+			}
+		}
+		return n;
+	}
+#endif
+}
+
+bool IsScoreKernelSupported(ScoreKernel kernel)
+{
+	switch (kernel)
+	{
+	case ScoreKernel::Scalar:
+		return true;
+#ifdef CVSS_X86_KERNELS
+	case ScoreKernel::SSE2:
+		return __builtin_cpu_supports("sse2");
+	case ScoreKernel::AVX2:
+		return __builtin_cpu_supports("avx2");
+#else
+	case ScoreKernel::SSE2:
+	case ScoreKernel::AVX2:
+		return false;
+#endif
+	case ScoreKernel::NEON:
+#ifdef CVSS_ARM_KERNELS
+		return true; //part of every AArch64 CPU, and of any 32-bit target compiled with __ARM_NEON
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+ScoreKernel GetScoreKernel()
+{
+	static const ScoreKernel kernel = IsScoreKernelSupported(ScoreKernel::AVX2) ? ScoreKernel::AVX2 : (IsScoreKernelSupported(ScoreKernel::SSE2) ? ScoreKernel::SSE2 : (IsScoreKernelSupported(ScoreKernel::NEON) ? ScoreKernel::NEON : ScoreKernel::Scalar));
+	return kernel;
+}
+
+const char *ScoreKernelString(ScoreKernel kernel)
+{
+	switch (kernel)
+	{
+	case ScoreKernel::Scalar:
+		return "scalar";
+	case ScoreKernel::SSE2:
+		return "sse2";
+	case ScoreKernel::AVX2:
+		return "avx2";
+	case ScoreKernel::NEON:
+		return "neon";
+	}
+	return "unknown";
+}
+
+void ScoreColumns(MetricColumns const& columns, float *base, float *temporal, float *environmental)
+{
+	ScoreColumns(columns, base, temporal, environmental, GetScoreKernel());
+}
+
+void ScoreColumns(MetricColumns const& columns, float *base, float *temporal, float *environmental, ScoreKernel kernel)
+{
+	Tables tables(base != nullptr, temporal != nullptr, environmental != nullptr);
+	size_t done = 0;
+#ifdef CVSS_X86_KERNELS
+	if ((kernel == ScoreKernel::AVX2) && IsScoreKernelSupported(kernel))
+		done = ScoreColumnsAVX2(columns, tables, base, temporal, environmental);
+	else if ((kernel == ScoreKernel::SSE2) && IsScoreKernelSupported(kernel))
+		done = ScoreColumnsSSE2(columns, tables, base, temporal, environmental);
+#endif
+#ifdef CVSS_ARM_KERNELS
+	if (kernel == ScoreKernel::NEON)
+		done = ScoreColumnsNEON(columns, tables, base, temporal, environmental);
+#endif
+	ScoreColumnsScalar(columns, done, tables, base, temporal, environmental); //remainder, or everything without a vector kernel
+}
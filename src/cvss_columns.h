@@ -0,0 +1,78 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_COLUMNS_H_
+#define HAVE_CVSS_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+const uint8_t MetricNotDefined = 0xFF; //modified metric column value for "X"
+
+//structure-of-arrays view of count CVSS 3.x vectors; every column holds the metric's enum value
+//(see cvss_3_1.h) and must have count entries
+struct MetricColumns
+{
+	size_t count = 0;
+
+	const uint8_t *version = nullptr; //CVSSVersion; only environmental scores depend on it, and V3_0 scores as 3.0 while null or any other value scores as 3.1
+
+	const uint8_t *av = nullptr;
+	const uint8_t *ac = nullptr;
+	const uint8_t *pr = nullptr;
+	const uint8_t *ui = nullptr;
+	const uint8_t *s = nullptr;
+	const uint8_t *c = nullptr;
+	const uint8_t *i = nullptr;
+	const uint8_t *a = nullptr;
+
+	const uint8_t *e = nullptr;
+	const uint8_t *rl = nullptr;
+	const uint8_t *rc = nullptr;
+
+	const uint8_t *cr = nullptr;
+	const uint8_t *ir = nullptr;
+	const uint8_t *ar = nullptr;
+	const uint8_t *mav = nullptr; //modified columns hold MetricNotDefined where the metric is not modified
+	const uint8_t *mac = nullptr;
+	const uint8_t *mpr = nullptr;
+	const uint8_t *mui = nullptr;
+	const uint8_t *ms = nullptr;
+	const uint8_t *mc = nullptr;
+	const uint8_t *mi = nullptr;
+	const uint8_t *ma = nullptr;
+};
+
+enum class ScoreKernel {
+	Scalar,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+ScoreKernel GetScoreKernel(); //best kernel the running CPU supports
+bool IsScoreKernelSupported(ScoreKernel kernel);
+const char *ScoreKernelString(ScoreKernel kernel);
+
+//fill count rounded scores into each non-null output array, bit-identical to the CVSS_3 and CVSS_3_1 score getters;
+//only the columns an output needs have to be set (base: AV-A, temporal: AV-RC, environmental: AV-A, CR-MA and optionally version)
+void ScoreColumns(MetricColumns const& columns, float *base, float *temporal, float *environmental);
+void ScoreColumns(MetricColumns const& columns, float *base, float *temporal, float *environmental, ScoreKernel kernel); //unsupported kernels fall back to Scalar
+
+#endif
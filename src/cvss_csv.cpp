@@ -0,0 +1,179 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_csv.h"
+
+#include <cstring>
+
+using namespace std;
+
+CSVIterator::CSVIterator(string_view data, char delimiter, size_t column, bool final) :
+	_data(data),
+	_position(0),
+	_rowNumber(0),
+	_delimiter(delimiter),
+	_column(column),
+	_final(final)
+{
+}
+
+size_t CSVIterator::EndQuoted(size_t position) const
+{
+	const char *data = _data.data();
+	size_t size = _data.size();
+	position++;
+	while (true)
+	{
+		const char *quote = static_cast<const char*>(memchr(data + position, '"', size - position));
+		if (!quote)
+			return string_view::npos;
+		position = quote - data + 1;
+		if ((position == size) && !_final)
+			return string_view::npos; //the next block may start with the other half of a doubled quote
+		if ((position == size) || (data[position] != '"'))
+			return position;
+		position++;
+	}
+}
+
+size_t CSVIterator::EndUnquoted(size_t position, size_t lineEnd) const
+{
+	const char *data = _data.data();
+	const char *delimiter = static_cast<const char*>(memchr(data + position, _delimiter, lineEnd - position));
+	return delimiter ? delimiter - data : lineEnd;
+}
+
+size_t CSVIterator::FindLineEnd(size_t position) const
+{
+	const char *data = _data.data();
+	const char *lineBreak = static_cast<const char*>(memchr(data + position, '\n', _data.size() - position));
+	return lineBreak ? lineBreak - data : _data.size();
+}
+
+bool CSVIterator::Next(string_view &row, string_view &ending, string_view &field, bool &hasField)
+{
+	const char *data = _data.data();
+	size_t size = _data.size();
+	if (_position >= size)
+		return false;
+
+	size_t position = _position;
+	size_t fieldStart = 0;
+	size_t fieldEnd = 0;
+	size_t quoteEnd = 0; //just after the closing quote of a quoted field
+	size_t fieldNumber = 0;
+	size_t lineEnd = FindLineEnd(position); //fields are searched for delimiters up to here with memchr
+	hasField = false;
+	while (true)
+	{
+		if (fieldNumber > _column)
+		{
+			//past the field, the row ends at the line break unless a quote comes first
+			if (!memchr(data + position, '"', lineEnd - position))
+			{
+				position = lineEnd;
+				break;
+			}
+		}
+
+		size_t start = position;
+		size_t closed = 0;
+		if ((position < size) && (data[position] == '"'))
+		{
+			position = EndQuoted(position);
+			if (position == string_view::npos)
+			{
+				if (!_final)
+					return false;
+				position = size;
+			}
+			closed = position;
+			if (position > lineEnd)
+				lineEnd = FindLineEnd(position); //the quotes held line breaks
+		}
+		position = EndUnquoted(position, lineEnd);
+		if (fieldNumber == _column)
+		{
+			hasField = true;
+			fieldStart = start;
+			fieldEnd = position;
+			quoteEnd = closed;
+		}
+		if ((position >= size) || (data[position] == '\n'))
+			break;
+		position++;
+		fieldNumber++;
+	}
+	if ((position >= size) && !_final)
+		return false; //the row may continue in the next block
+
+	row = _data.substr(_position, position - _position);
+	ending = _data.substr(position, (position < size) ? 1 : 0);
+	if (!ending.empty() && !row.empty() && (row.back() == '\r'))
+	{
+		row.remove_suffix(1);
+		ending = _data.substr(position - 1, 2);
+		if (hasField && (fieldEnd == position) && (fieldEnd > max(fieldStart, quoteEnd)))
+			fieldEnd--;
+	}
+
+	if (hasField && quoteEnd)
+	{
+		//strip the quotes, collapse doubled quotes and keep anything after the closing quote
+		string_view inner = _data.substr(fieldStart + 1, ((quoteEnd > fieldStart + 1) && (data[quoteEnd - 1] == '"') ? quoteEnd - 1 : quoteEnd) - fieldStart - 1);
+		string_view trailing = _data.substr(quoteEnd, fieldEnd - quoteEnd);
+		if ((inner.find('"') == string_view::npos) && trailing.empty())
+		{
+			field = inner;
+		}
+		else
+		{
+			_unquoted.clear();
+			for (size_t n = 0; n < inner.size(); n++)
+			{
+				_unquoted.push_back(inner[n]);
+				if (inner[n] == '"')
+					n++;
+			}
+			_unquoted.append(trailing);
+			field = _unquoted;
+		}
+	}
+	else if (hasField)
+	{
+		field = _data.substr(fieldStart, fieldEnd - fieldStart);
+	}
+	else
+	{
+		field = string_view();
+	}
+
+	_position = (position < size) ? position + 1 : size;
+	_rowNumber++;
+	return true;
+}
+
+size_t CSVIterator::GetRowNumber() const
+{
+	return _rowNumber;
+}
+
+size_t CSVIterator::GetPosition() const
+{
+	return _position;
+}
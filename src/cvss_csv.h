@@ -0,0 +1,52 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_CSV_H_
+#define HAVE_CVSS_CSV_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//walks CSV (RFC 4180) or TSV rows, yielding each row (without its line ending) and one of its fields as views
+//into the original data. A field that starts with a quote may hold delimiters, line breaks and doubled quotes;
+//its quotes are removed from the yielded field. Rows past the field are only searched for their end
+class CSVIterator
+{
+	private:
+		std::string_view _data;
+		size_t _position;
+		size_t _rowNumber;
+		char _delimiter;
+		size_t _column;
+		bool _final;
+		std::string _unquoted; //the field without its quotes, when they had to be removed
+
+		size_t EndQuoted(size_t position) const; //position just after the closing quote, or npos if the data ends first
+		size_t EndUnquoted(size_t position, size_t lineEnd) const; //position of the next delimiter before lineEnd, or lineEnd
+		size_t FindLineEnd(size_t position) const; //position of the next '\n', or the end of the data
+
+	public:
+		CSVIterator(std::string_view data, char delimiter, size_t column, bool final = true); //column is 0-based; unless final, data may end part way through a row
+		bool Next(std::string_view &row, std::string_view &ending, std::string_view &field, bool &hasField); //false once every (complete) row has been returned; hasField is false for rows with too few fields
+		size_t GetRowNumber() const; //1-based number of the row last returned
+		size_t GetPosition() const; //bytes of data consumed by the rows returned so far
+};
+
+#endif
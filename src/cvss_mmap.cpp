@@ -0,0 +1,139 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_mmap.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CVSS_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+using namespace std;
+
+MappedFile::MappedFile() :
+	_data(nullptr),
+	_size(0),
+	_open(false)
+{
+}
+
+MappedFile::MappedFile(string const& path) : MappedFile()
+{
+	Open(path);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(string const& path)
+{
+	Close();
+#ifdef CVSS_HAVE_MMAP
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat info;
+	if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode))
+	{
+		close(fd);
+		return false;
+	}
+	_size = static_cast<size_t>(info.st_size);
+	if (_size > 0)
+	{
+		void *map = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map == MAP_FAILED)
+		{
+			close(fd);
+			_size = 0;
+			return false;
+		}
+		madvise(map, _size, MADV_SEQUENTIAL);
+		_data = static_cast<const char*>(map);
+	}
+	close(fd); //the mapping stays valid without the descriptor
+#else
+	ifstream in(path, ios::binary);
+	if (!in)
+		return false;
+	_buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+	_data = _buffer.data();
+	_size = _buffer.size();
+#endif
+	_open = true;
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef CVSS_HAVE_MMAP
+	if (_data)
+		munmap(const_cast<char*>(_data), _size);
+#else
+	_buffer.clear();
+#endif
+	_data = nullptr;
+	_size = 0;
+	_open = false;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return _open;
+}
+
+string_view MappedFile::GetData() const
+{
+	return string_view(_data, _size);
+}
+
+LineIterator::LineIterator(string_view data) :
+	_data(data),
+	_position(0),
+	_lineNumber(0)
+{
+}
+
+bool LineIterator::Next(string_view &line)
+{
+	if (_position >= _data.length())
+		return false;
+	size_t end = _data.find('\n', _position);
+	if (end == string_view::npos)
+		end = _data.length();
+	line = _data.substr(_position, end - _position);
+	if (!line.empty() && (line.back() == '\r'))
+		line.remove_suffix(1);
+	_position = end + 1;
+	_lineNumber++;
+	return true;
+}
+
+size_t LineIterator::GetLineNumber() const
+{
+	return _lineNumber;
+}
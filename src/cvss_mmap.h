@@ -0,0 +1,64 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_MMAP_H_
+#define HAVE_CVSS_MMAP_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//read-only memory map of a whole file, advised for sequential access
+//(platforms without mmap read the file into memory instead)
+class MappedFile
+{
+	private:
+		const char *_data;
+		size_t _size;
+		bool _open;
+		std::string _buffer; //only used without mmap
+
+	public:
+		MappedFile();
+		explicit MappedFile(std::string const& path);
+		~MappedFile();
+		MappedFile(MappedFile const&) = delete;
+		MappedFile &operator=(MappedFile const&) = delete;
+
+		bool Open(std::string const& path); //false if the file cannot be opened or mapped (e.g. a pipe)
+		void Close();
+		bool IsOpen() const;
+		std::string_view GetData() const;
+};
+
+//walks newline-delimited text, yielding each line (without "\n" or "\r\n") as a view into the original data
+class LineIterator
+{
+	private:
+		std::string_view _data;
+		size_t _position;
+		size_t _lineNumber;
+
+	public:
+		explicit LineIterator(std::string_view data);
+		bool Next(std::string_view &line); //false once every line has been returned
+		size_t GetLineNumber() const; //1-based number of the line last returned
+};
+
+#endif
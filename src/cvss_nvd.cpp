@@ -0,0 +1,129 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_nvd.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+NVDScanner::NVDScanner(Callback callback) :
+	_callback(callback)
+{
+	Reset();
+}
+
+void NVDScanner::Reset()
+{
+	_string.clear();
+	_string.reserve(MaxString);
+	_stringLength = 0;
+	_id.clear();
+	_key = Key::Other;
+	_inString = false;
+	_escape = false;
+	_afterString = false;
+	_expectValue = false;
+}
+
+void NVDScanner::EndString()
+{
+	_inString = false;
+	bool whole = (_stringLength == _string.size());
+	if (_expectValue)
+	{
+		_expectValue = false;
+		if (whole && (_key == Key::Id) && (_string.compare(0, 4, "CVE-") == 0))
+			_id = _string;
+		else if (whole && (_key == Key::VectorString))
+			_callback(_id, _string);
+		return;
+	}
+
+	//the string is a key if a ':' follows it
+	_afterString = true;
+	if (whole && ((_string == "id") || (_string == "ID")))
+		_key = Key::Id;
+	else if (whole && (_string == "vectorString"))
+		_key = Key::VectorString;
+	else
+		_key = Key::Other;
+}
+
+void NVDScanner::Feed(string_view data)
+{
+	const char *position = data.data();
+	const char *end = data.data() + data.size();
+	while (position < end)
+	{
+		if (_inString)
+		{
+			//most of a feed is description text, so strings are skipped a quote at a time
+			const char *quote = static_cast<const char*>(memchr(position, '"', end - position));
+			const char *stop = quote ? quote : end;
+			size_t backslashes = 0;
+			for (const char *p = stop; (p > position) && (p[-1] == '\\'); p--)
+				backslashes++;
+			bool escaped = (backslashes == static_cast<size_t>(stop - position)) ? ((backslashes + (_escape ? 1 : 0)) % 2 == 1) : (backslashes % 2 == 1);
+
+			size_t length = stop - position;
+			if (_string.size() < MaxString)
+				_string.append(position, min(length, MaxString - _string.size()));
+			_stringLength += length;
+			if (!quote)
+			{
+				_escape = escaped;
+				break;
+			}
+			position = quote + 1;
+			if (escaped)
+			{
+				//an escaped quote is part of the string
+				if (_string.size() < MaxString)
+					_string.push_back('"');
+				_stringLength++;
+				_escape = false;
+				continue;
+			}
+			_escape = false;
+			EndString();
+			continue;
+		}
+
+		char c = *position++;
+		if (c == '"')
+		{
+			_inString = true;
+			_afterString = false;
+			_string.clear();
+			_stringLength = 0;
+		}
+		else if (c == ':')
+		{
+			_expectValue = _afterString;
+			_afterString = false;
+		}
+		else if ((c != ' ') && (c != '\n') && (c != '\r') && (c != '\t'))
+		{
+			//a number, literal, object or array: neither a key nor a string value
+			_afterString = false;
+			_expectValue = false;
+		}
+	}
+}
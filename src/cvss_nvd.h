@@ -0,0 +1,63 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_NVD_H_
+#define HAVE_CVSS_NVD_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+//streaming extractor for NVD CVE JSON feeds (2.0, and the "ID" keys of 1.1); it keeps no document, only the
+//string being read and the last CVE ID, so a feed can be fed in blocks of any size. Each "vectorString" value
+//is reported with the CVE ID ("id" or "ID" starting with "CVE-") that last preceded it
+class NVDScanner
+{
+	public:
+		typedef std::function<void(std::string_view id, std::string_view vector)> Callback;
+
+	private:
+		enum class Key {
+			Other,
+			Id,
+			VectorString
+		};
+
+		static const size_t MaxString = 256; //longer strings are never IDs or vectors, so only their start is kept
+
+		Callback _callback;
+		std::string _string; //current string, up to MaxString bytes
+		size_t _stringLength; //its full length
+		std::string _id;
+		Key _key;
+		bool _inString;
+		bool _escape; //the last byte read in the string was an unescaped backslash
+		bool _afterString; //a string just ended, so a ':' makes it a key
+		bool _expectValue; //a key and its ':' were read, so a string is its value
+
+		void EndString();
+
+	public:
+		explicit NVDScanner(Callback callback);
+		void Feed(std::string_view data); //the next block of the feed
+		void Reset(); //start a new feed
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_packed.h"
+#include "cvss_table.h"
+
+static_assert(sizeof(PackedVector) == sizeof(uint64_t), "PackedVector must stay one word");
+
+namespace
+{
+	const unsigned BaseShift = 0;
+	const unsigned TemporalShift = 12;
+	const unsigned CRShift = 19;
+	const unsigned IRShift = 21;
+	const unsigned ARShift = 23;
+	const unsigned MAVShift = 25; //3 bits
+	const unsigned MACShift = 28; //2 bits
+	const unsigned MPRShift = 30; //3 bits
+	const unsigned MUIShift = 33; //2 bits
+	const unsigned MSShift = 35; //2 bits
+	const unsigned MCShift = 37; //3 bits
+	const unsigned MIShift = 40; //3 bits
+	const unsigned MAShift = 43; //3 bits
+	const unsigned VersionShift = 46;
+
+	uint64_t Field(uint64_t bits, unsigned shift, unsigned width)
+	{
+		return (bits >> shift) & ((uint64_t(1) << width) - 1);
+	}
+
+	template<typename T> uint64_t PackModified(Modified<T> m)
+	{
+		return (static_cast<uint64_t>(m.parent) << 1) | (m.modified ? 1 : 0);
+	}
+
+	template<typename T> Modified<T> UnpackModified(uint64_t field)
+	{
+		return { static_cast<T>(field >> 1), (field & 1) != 0 };
+	}
+}
+
+PackedVector::PackedVector() : PackedVector(ParsedVector())
+{
+}
+
+PackedVector::PackedVector(ParsedVector const& v) :
+	_bits(0)
+{
+	_bits |= static_cast<uint64_t>(::GetBaseIndex(v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a)) << BaseShift;
+	_bits |= static_cast<uint64_t>(::GetTemporalIndex(v.e, v.rl, v.rc)) << TemporalShift;
+	_bits |= static_cast<uint64_t>(v.cr) << CRShift;
+	_bits |= static_cast<uint64_t>(v.ir) << IRShift;
+	_bits |= static_cast<uint64_t>(v.ar) << ARShift;
+	_bits |= PackModified(v.mav) << MAVShift;
+	_bits |= PackModified(v.mac) << MACShift;
+	_bits |= PackModified(v.mpr) << MPRShift;
+	_bits |= PackModified(v.mui) << MUIShift;
+	_bits |= PackModified(v.ms) << MSShift;
+	_bits |= PackModified(v.mc) << MCShift;
+	_bits |= PackModified(v.mi) << MIShift;
+	_bits |= PackModified(v.ma) << MAShift;
+	_bits |= static_cast<uint64_t>(v.version) << VersionShift;
+}
+
+PackedVector::PackedVector(uint64_t bits) :
+	_bits(bits)
+{
+}
+
+uint64_t PackedVector::GetBits() const
+{
+	return _bits;
+}
+
+ParsedVector PackedVector::Unpack() const
+{
+	ParsedVector ret;
+	ret.version = GetVersion();
+
+	GetBaseMetrics(GetBaseIndex(), ret.av, ret.ac, ret.pr, ret.ui, ret.s, ret.c, ret.i, ret.a);
+	GetTemporalMetrics(GetTemporalIndex(), ret.e, ret.rl, ret.rc);
+	ret.cr = static_cast<Requirement>(Field(_bits, CRShift, 2));
+	ret.ir = static_cast<Requirement>(Field(_bits, IRShift, 2));
+	ret.ar = static_cast<Requirement>(Field(_bits, ARShift, 2));
+	ret.mav = UnpackModified<AttackVector>(Field(_bits, MAVShift, 3));
+	ret.mac = UnpackModified<AttackComplexity>(Field(_bits, MACShift, 2));
+	ret.mpr = UnpackModified<PrivilegesRequired>(Field(_bits, MPRShift, 3));
+	ret.mui = UnpackModified<UserInteraction>(Field(_bits, MUIShift, 2));
+	ret.ms = UnpackModified<Scope>(Field(_bits, MSShift, 2));
+	ret.mc = UnpackModified<Impact>(Field(_bits, MCShift, 3));
+	ret.mi = UnpackModified<Impact>(Field(_bits, MIShift, 3));
+	ret.ma = UnpackModified<Impact>(Field(_bits, MAShift, 3));
+	return ret;
+}
+
+CVSSVersion PackedVector::GetVersion() const
+{
+	return static_cast<CVSSVersion>(Field(_bits, VersionShift, 2));
+}
+
+size_t PackedVector::GetBaseIndex() const
+{
+	return static_cast<size_t>(Field(_bits, BaseShift, 12));
+}
+
+size_t PackedVector::GetTemporalIndex() const
+{
+	return static_cast<size_t>(Field(_bits, TemporalShift, 7));
+}
+
+float PackedVector::GetBaseScore() const
+{
+	return LookupBaseScore(GetBaseIndex());
+}
+
+float PackedVector::GetTemporalScore() const
+{
+	return LookupTemporalScore(GetBaseIndex(), GetTemporalIndex());
+}
+
+float PackedVector::GetEnvironmentalScore() const
+{
+	ParsedVector v = Unpack();
+	size_t modifiedBaseIndex = ::GetBaseIndex(GetModifiedValue(v.av, v.mav), GetModifiedValue(v.ac, v.mac), GetModifiedValue(v.pr, v.mpr), GetModifiedValue(v.ui, v.mui), GetModifiedValue(v.s, v.ms), GetModifiedValue(v.c, v.mc), GetModifiedValue(v.i, v.mi), GetModifiedValue(v.a, v.ma));
+	return LookupEnvironmentalScore(v.version, modifiedBaseIndex, GetRequirementIndex(v.cr, v.ir, v.ar));
+}
+
+bool PackedVector::operator==(PackedVector const& other) const
+{
+	return _bits == other._bits;
+}
+
+bool PackedVector::operator!=(PackedVector const& other) const
+{
+	return _bits != other._bits;
+}
@@ -0,0 +1,59 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_PACKED_H_
+#define HAVE_CVSS_PACKED_H_
+
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//a complete CVSS 3.x vector in one 64-bit word
+//bits  0-11 base table index (see GetBaseIndex())
+//bits 12-18 temporal table index (see GetTemporalIndex())
+//bits 19-24 CR, IR, AR (2 bits each)
+//bits 25-45 MAV, MAC, MPR, MUI, MS, MC, MI, MA (value followed by a modified bit)
+//bits 46-47 version
+class PackedVector
+{
+	private:
+		uint64_t _bits;
+
+	public:
+		PackedVector(); //same defaults as ParsedVector
+		explicit PackedVector(ParsedVector const& v);
+		explicit PackedVector(uint64_t bits);
+
+		uint64_t GetBits() const;
+		ParsedVector Unpack() const; //error fields are always ParseError::None
+
+		CVSSVersion GetVersion() const;
+		size_t GetBaseIndex() const;
+		size_t GetTemporalIndex() const;
+
+		float GetBaseScore() const; //Base Score
+		float GetTemporalScore() const; //Temporal Score
+		float GetEnvironmentalScore() const; //Environmental Score
+
+		bool operator==(PackedVector const& other) const;
+		bool operator!=(PackedVector const& other) const;
+};
+
+#endif
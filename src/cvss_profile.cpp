@@ -0,0 +1,158 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_profile.h"
+#include "cvss_stats.h"
+#include "cvss_table.h"
+
+using namespace std;
+
+namespace
+{
+	//environmental metrics a profile may set, in ParseError order
+	const string_view ProfileKeys[] = { "CR", "IR", "AR", "MAV", "MAC", "MPR", "MUI", "MS", "MC", "MI", "MA" };
+	const size_t ProfileKeyCount = sizeof(ProfileKeys) / sizeof(ProfileKeys[0]);
+
+	bool HasEnvironmentalMetrics(ParsedVector const& v)
+	{
+		return (v.cr != Requirement::NotDefined) || (v.ir != Requirement::NotDefined) || (v.ar != Requirement::NotDefined) ||
+			v.mav.modified || v.mac.modified || v.mpr.modified || v.mui.modified || v.ms.modified || v.mc.modified || v.mi.modified || v.ma.modified;
+	}
+
+	float EnvironmentalScore(ParsedVector const& v)
+	{
+		size_t modifiedBaseIndex = GetBaseIndex(GetModifiedValue(v.av, v.mav), GetModifiedValue(v.ac, v.mac), GetModifiedValue(v.pr, v.mpr), GetModifiedValue(v.ui, v.mui), GetModifiedValue(v.s, v.ms), GetModifiedValue(v.c, v.mc), GetModifiedValue(v.i, v.mi), GetModifiedValue(v.a, v.ma));
+		return LookupEnvironmentalScore(v.version, modifiedBaseIndex, GetRequirementIndex(v.cr, v.ir, v.ar));
+	}
+}
+
+EnvironmentalProfile::EnvironmentalProfile() :
+	_set(0)
+{
+}
+
+ParseError EnvironmentalProfile::Parse(string_view profile, size_t *errorOffset, size_t *errorLength)
+{
+	//only environmental components are allowed; ParseVector() then reads their values
+	uint16_t set = 0;
+	size_t start = 0;
+	while (true)
+	{
+		size_t end = profile.find('/', start);
+		string_view component = profile.substr(start, (end == string_view::npos) ? string_view::npos : end - start);
+		string_view key = component.substr(0, component.find(':'));
+		size_t k = 0;
+		while ((k < ProfileKeyCount) && (ProfileKeys[k] != key))
+			k++;
+		if ((k == ProfileKeyCount) || (key.length() == component.length()))
+		{
+			if (errorOffset)
+				*errorOffset = start;
+			if (errorLength)
+				*errorLength = component.length();
+			return ParseError::UnknownComponent;
+		}
+		set |= static_cast<uint16_t>(1u << k);
+		if (end == string_view::npos)
+			break;
+		start = end + 1;
+	}
+
+	ParsedVector parsed = ParseVector(profile);
+	if (parsed.error != ParseError::None)
+	{
+		if (errorOffset)
+			*errorOffset = parsed.errorOffset;
+		if (errorLength)
+			*errorLength = parsed.errorLength;
+		return parsed.error;
+	}
+	_profile = parsed;
+	_set = set;
+
+	//hoist everything the profile fixes: score every base vector under it once
+	_environmental.resize(VersionTableSize * BaseTableSize);
+	for (size_t version = 0; version < VersionTableSize; version++)
+		for (size_t b = 0; b < BaseTableSize; b++)
+		{
+			ParsedVector v;
+			v.version = static_cast<CVSSVersion>(version);
+			GetBaseMetrics(b, v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a);
+			Apply(v);
+			_environmental[version * BaseTableSize + b] = EnvironmentalScore(v);
+		}
+	return ParseError::None;
+}
+
+void EnvironmentalProfile::Apply(ParsedVector &vector) const
+{
+	if (_set & (1u << 0))
+		vector.cr = _profile.cr;
+	if (_set & (1u << 1))
+		vector.ir = _profile.ir;
+	if (_set & (1u << 2))
+		vector.ar = _profile.ar;
+	if (_set & (1u << 3))
+		vector.mav = _profile.mav;
+	if (_set & (1u << 4))
+		vector.mac = _profile.mac;
+	if (_set & (1u << 5))
+		vector.mpr = _profile.mpr;
+	if (_set & (1u << 6))
+		vector.mui = _profile.mui;
+	if (_set & (1u << 7))
+		vector.ms = _profile.ms;
+	if (_set & (1u << 8))
+		vector.mc = _profile.mc;
+	if (_set & (1u << 9))
+		vector.mi = _profile.mi;
+	if (_set & (1u << 10))
+		vector.ma = _profile.ma;
+}
+
+ScoreResult EnvironmentalProfile::Score(ParsedVector const& vector) const
+{
+	if ((vector.error != ParseError::None) || (_set == 0) || HasEnvironmentalMetrics(vector))
+	{
+		ParsedVector overlaid = vector;
+		Apply(overlaid);
+		return ::Score(overlaid);
+	}
+
+	CVSS_STAGE_TIMER(Stage::Score);
+	ScoreResult ret;
+	ret.version = vector.version;
+	size_t baseIndex = GetBaseIndex(vector.av, vector.ac, vector.pr, vector.ui, vector.s, vector.c, vector.i, vector.a);
+	ret.base = LookupBaseScore(baseIndex);
+	ret.temporal = LookupTemporalScore(baseIndex, GetTemporalIndex(vector.e, vector.rl, vector.rc));
+	ret.environmental = _environmental[static_cast<size_t>(vector.version) * BaseTableSize + baseIndex];
+	return ret;
+}
+
+ScoreResult EnvironmentalProfile::Score(string_view data) const
+{
+	if (GetVectorGrammar(data) != VectorGrammar::V3)
+		return ::Score(data);
+	return Score(InstrumentedParseVector(data));
+}
+
+void EnvironmentalProfile::Score(string_view const *vectors, size_t count, ScoreResult *results) const
+{
+	for (size_t n = 0; n < count; n++)
+		results[n] = Score(vectors[n]);
+}
@@ -0,0 +1,56 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_PROFILE_H_
+#define HAVE_CVSS_PROFILE_H_
+
+#include "cvss_score.h"
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+//environmental metrics (CR, IR, AR and the modified base metrics, e.g. "CR:H/IR:H/MAV:L") parsed once and
+//overlaid on many vectors; the profile's metrics replace the vector's own
+//profiles hold 3.x metrics, so 2.0 and 4.0 vectors are scored as given
+class EnvironmentalProfile
+{
+	private:
+		ParsedVector _profile;
+		uint16_t _set; //bit per environmental metric the profile sets, in ParseError order from ConfidentialityRequirement
+		std::vector<float> _environmental; //VersionTableSize x BaseTableSize: environmental score of each base vector under the profile
+
+	public:
+		EnvironmentalProfile(); //overlays nothing
+
+		//replace the profile; on error the profile is left unchanged and the offset and length locate the bad component or value
+		ParseError Parse(std::string_view profile, size_t *errorOffset = nullptr, size_t *errorLength = nullptr);
+
+		void Apply(ParsedVector &vector) const; //overlay the profile's metrics
+
+		//same as ::Score() of the overlaid vector; vectors without environmental metrics of their own (the usual
+		//case) take their environmental score straight from the table built by Parse()
+		ScoreResult Score(ParsedVector const& vector) const;
+		ScoreResult Score(std::string_view data) const;
+		void Score(std::string_view const *vectors, size_t count, ScoreResult *results) const;
+};
+
+#endif
@@ -0,0 +1,135 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_score.h"
+#include "cvss_2_engine.h"
+#include "cvss_3_engine.h"
+#include "cvss_3_integer.h"
+#include "cvss_4_engine.h"
+#include "cvss_stats.h"
+#include "cvss_table.h"
+#include <cmath>
+
+using namespace std;
+
+//the constexpr parser and engine must keep working as constant expressions
+static_assert(ComputeScore("CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H"_cvss).base == 9.8f, "constexpr base score");
+static_assert(ComputeScore("CVSS:3.1/AV:N/AC:L/PR:L/UI:N/S:C/C:H/I:H/A:H/E:P/RL:O/RC:C/MS:C/MC:H/CR:H"_cvss).temporal == 8.9f, "constexpr temporal score");
+static_assert(ComputeScore("CVSS:3.1/AV:N/AC:L/PR:L/UI:N/S:C/C:H/I:H/A:H/E:P/RL:O/RC:C/MS:C/MC:H/CR:H"_cvss).environmental == 10.0f, "constexpr 3.1 environmental score");
+static_assert(ComputeScore("CVSS:3.0/AV:N/AC:L/PR:L/UI:N/S:C/C:H/I:H/A:H/E:P/RL:O/RC:C/MS:C/MC:H/CR:H"_cvss).environmental == 9.9f, "constexpr 3.0 environmental score");
+static_assert(ComputeScore(ParseVector4("CVSS:4.0/AV:N/AC:L/AT:N/PR:N/UI:N/VC:H/VI:H/VA:H/SC:N/SI:N/SA:N")).base == 9.3f, "constexpr 4.0 base score");
+static_assert(ComputeScore(ParseVector4("CVSS:4.0/AV:L/AC:L/AT:N/PR:L/UI:N/VC:N/VI:N/VA:H/SC:N/SI:N/SA:N")).base == 6.8f, "constexpr 4.0 interpolated score");
+static_assert(ComputeScore(ParseVector2("AV:N/AC:L/Au:N/C:N/I:N/A:C/E:F/RL:OF/RC:C")).temporal == 6.4f, "constexpr 2.0 temporal score");
+static_assert(ComputeScore(ParseVector2("AV:N/AC:L/Au:N/C:N/I:N/A:C/E:F/RL:OF/RC:C/CDP:H/TD:H/CR:M/IR:M/AR:H")).environmental == 9.2f, "constexpr 2.0 environmental score");
+static_assert(ComputeIntegerScore("CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:C/C:H/I:H/A:H/RL:W"_cvss).temporal == 9.7f, "integer temporal score is exact where float rounds 9.7 up to 9.8");
+
+ScoreResult Score(ParsedVector const& v)
+{
+	CVSS_STAGE_TIMER(Stage::Score);
+	ScoreResult ret;
+	ret.version = v.version;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	//base and temporal scores are version-independent; only the environmental table is split by version
+	size_t baseIndex = GetBaseIndex(v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a);
+	size_t modifiedBaseIndex = GetBaseIndex(GetModifiedValue(v.av, v.mav), GetModifiedValue(v.ac, v.mac), GetModifiedValue(v.pr, v.mpr), GetModifiedValue(v.ui, v.mui), GetModifiedValue(v.s, v.ms), GetModifiedValue(v.c, v.mc), GetModifiedValue(v.i, v.mi), GetModifiedValue(v.a, v.ma));
+	ret.base = LookupBaseScore(baseIndex);
+	ret.temporal = LookupTemporalScore(baseIndex, GetTemporalIndex(v.e, v.rl, v.rc));
+	ret.environmental = LookupEnvironmentalScore(v.version, modifiedBaseIndex, GetRequirementIndex(v.cr, v.ir, v.ar));
+	return ret;
+}
+
+ScoreResult Score(ParsedVector4 const& v)
+{
+	CVSS_STAGE_TIMER(Stage::Score);
+	return ComputeScore(v);
+}
+
+ScoreResult Score(ParsedVector2 const& v)
+{
+	CVSS_STAGE_TIMER(Stage::Score);
+	ScoreResult ret;
+	ret.version = CVSSVersion::V2_0;
+	ret.error = v.error;
+	ret.errorOffset = v.errorOffset;
+	ret.errorLength = v.errorLength;
+	if (v.error != ParseError::None)
+		return ret;
+
+	//Not Defined requirements weigh the same as Medium, which leaves the Base Score
+	size_t baseIndex = GetBaseIndex(v.av, v.ac, v.au, v.c, v.i, v.a);
+	size_t temporalIndex = GetTemporalIndex(v.e, v.rl, v.rc);
+	uint8_t base = LookupBaseTenths2(baseIndex, GetRequirementIndex(Requirement::Medium, Requirement::Medium, Requirement::Medium));
+	uint8_t adjustedTemporal = LookupTemporalTenths2(LookupBaseTenths2(baseIndex, GetRequirementIndex(v.cr, v.ir, v.ar)), temporalIndex);
+	const float *tenths = GetTenthsTable();
+	ret.base = tenths[base];
+	ret.temporal = tenths[LookupTemporalTenths2(base, temporalIndex)];
+	ret.environmental = tenths[LookupEnvironmentalTenths2(adjustedTemporal, GetDamageIndex(v.cdp, v.td))];
+	return ret;
+}
+
+ScoreResult Score(string_view data)
+{
+	switch (GetVectorGrammar(data))
+	{
+	case VectorGrammar::V2:
+		return Score(InstrumentedParseVector2(data));
+	case VectorGrammar::V4:
+		return Score(InstrumentedParseVector4(data));
+	case VectorGrammar::V3:
+		break;
+	}
+	return Score(InstrumentedParseVector(data));
+}
+
+Severity GetSeverity(float score)
+{
+	long tenths = lround(score * 10.0);
+	if (tenths >= 90)
+		return Severity::Critical;
+	if (tenths >= 70)
+		return Severity::High;
+	if (tenths >= 40)
+		return Severity::Medium;
+	if (tenths >= 1)
+		return Severity::Low;
+	return Severity::None;
+}
+
+const char *SeverityString(Severity severity)
+{
+	switch (severity)
+	{
+	case Severity::None:
+		return "None";
+	case Severity::Low:
+		return "Low";
+	case Severity::Medium:
+		return "Medium";
+	case Severity::High:
+		return "High";
+	case Severity::Critical:
+		return "Critical";
+	}
+	return "";
+}
@@ -0,0 +1,59 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_SCORE_H_
+#define HAVE_CVSS_SCORE_H_
+
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//rounded scores of one vector; check error before using the scores
+struct ScoreResult
+{
+	CVSSVersion version = CVSSVersion::V3_1;
+	float base = 0; //Base Score
+	float temporal = 0; //Temporal Score
+	float environmental = 0; //Environmental Score
+
+	ParseError error = ParseError::None;
+	size_t errorOffset = 0; //see ParsedVector::errorOffset
+	size_t errorLength = 0; //see ParsedVector::errorLength
+};
+
+//qualitative severity rating scale
+enum class Severity : uint8_t {
+	None, //0.0
+	Low, //0.1 - 3.9
+	Medium, //4.0 - 6.9
+	High, //7.0 - 8.9
+	Critical //9.0 - 10.0
+};
+
+Severity GetSeverity(float score); //score must already be rounded
+const char *SeverityString(Severity severity);
+
+ScoreResult Score(std::string_view data); //parse and score without allocating or touching iostreams; "CVSS:4.0/..." uses the 4.0 grammar and "AV:N/AC:L/Au:N/..." the 2.0 one
+ScoreResult Score(ParsedVector const& vector);
+ScoreResult Score(ParsedVector4 const& vector);
+ScoreResult Score(ParsedVector2 const& vector);
+
+#endif
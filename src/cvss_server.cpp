@@ -0,0 +1,229 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_server.h"
+#include "cvss_cache.h"
+#include "cvss_profile.h"
+#include "cvss_score.h"
+#include "cvss_vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+	//AppendScore() without to_string(), so an answer never allocates
+	void AppendTenths(string &output, float score)
+	{
+		long tenths = lround(score * 10.0);
+		if (tenths >= 100)
+			output.append("10");
+		else
+			output.push_back(static_cast<char>('0' + tenths / 10));
+		if (tenths % 10 != 0)
+		{
+			output.push_back('.');
+			output.push_back(static_cast<char>('0' + tenths % 10));
+		}
+	}
+
+	size_t GetLatencyBucket(uint64_t nanoseconds)
+	{
+		if (nanoseconds < LatencyHistogram::SubBuckets)
+			return static_cast<size_t>(nanoseconds);
+		//the top 4 bits of the duration: its power of two and the eighth of it
+		size_t power = 3;
+		while ((nanoseconds >> (power - 3)) >= 2 * LatencyHistogram::SubBuckets)
+			power++;
+		size_t bucket = (power - 2) * LatencyHistogram::SubBuckets + static_cast<size_t>((nanoseconds >> (power - 3)) - LatencyHistogram::SubBuckets);
+		return min(bucket, LatencyHistogram::Buckets - 1);
+	}
+
+	uint64_t GetLatencyBucketLimit(size_t bucket)
+	{
+		if (bucket < LatencyHistogram::SubBuckets)
+			return bucket;
+		size_t power = bucket / LatencyHistogram::SubBuckets + 2;
+		uint64_t eighths = LatencyHistogram::SubBuckets + bucket % LatencyHistogram::SubBuckets;
+		return ((eighths + 1) << (power - 3)) - 1;
+	}
+}
+
+void LatencyHistogram::Add(uint64_t nanoseconds)
+{
+	counts[GetLatencyBucket(nanoseconds)]++;
+}
+
+void LatencyHistogram::Merge(LatencyHistogram const& other)
+{
+	for (size_t n = 0; n < Buckets; n++)
+		counts[n] += other.counts[n];
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+	uint64_t ret = 0;
+	for (size_t n = 0; n < Buckets; n++)
+		ret += counts[n];
+	return ret;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const
+{
+	uint64_t count = GetCount();
+	if (count == 0)
+		return 0;
+	uint64_t rank = max<uint64_t>(static_cast<uint64_t>(ceil(percentile / 100.0 * count)), 1);
+	uint64_t seen = 0;
+	for (size_t n = 0; n < Buckets; n++)
+	{
+		seen += counts[n];
+		if (seen >= rank)
+			return GetLatencyBucketLimit(n);
+	}
+	return GetLatencyBucketLimit(Buckets - 1);
+}
+
+string ServerStats::Format() const
+{
+	return "requests " + to_string(requests) + "\terrors " + to_string(errors) + "\tconnections " + to_string(connections) + "\tp50_ns " + to_string(latency.GetPercentile(50)) + "\tp99_ns " + to_string(latency.GetPercentile(99));
+}
+
+ScoreSession::ScoreSession(bool baseScore, bool temporalScore, bool environmentalScore, ScoreCache *cache, EnvironmentalProfile const *profile, ServerStats *stats) :
+	_baseScore(baseScore || (!temporalScore && !environmentalScore)),
+	_temporalScore(temporalScore),
+	_environmentalScore(environmentalScore),
+	_cache(cache),
+	_profile(profile),
+	_stats(stats)
+{
+}
+
+void ScoreSession::Answer(string_view request, string &output, bool frame)
+{
+	size_t start = output.size();
+	if (frame)
+		output.append(FrameHeaderSize, '\0');
+
+	if (request == "STATS")
+	{
+		output.append(_stats ? _stats->Format() : ServerStats().Format());
+	}
+	else
+	{
+		ScoreResult result = _cache ? _cache->Score(request) : (_profile ? _profile->Score(request) : Score(request));
+		if (result.error == ParseError::None)
+		{
+			const char *separator = "";
+			if (_baseScore)
+			{
+				AppendTenths(output, result.base);
+				separator = "\t";
+			}
+			if (_temporalScore)
+			{
+				output.append(separator);
+				AppendTenths(output, result.temporal);
+				separator = "\t";
+			}
+			if (_environmentalScore)
+			{
+				output.append(separator);
+				AppendTenths(output, result.environmental);
+			}
+		}
+		else
+		{
+			output.append("error\t");
+			output.append(ParseErrorString(result.error));
+			output.append((result.error == ParseError::UnsupportedVersion) ? " " : ": ");
+			output.append(request.substr(min(result.errorOffset, request.size()), result.errorLength));
+		}
+		if (_stats)
+		{
+			_stats->requests++;
+			if (result.error != ParseError::None)
+				_stats->errors++;
+		}
+	}
+
+	if (frame)
+	{
+		size_t length = output.size() - start - FrameHeaderSize;
+		for (size_t n = 0; n < FrameHeaderSize; n++)
+			output[start + n] = static_cast<char>((length >> (8 * (FrameHeaderSize - 1 - n))) & 0xFF);
+	}
+	else
+	{
+		output.push_back('\n');
+	}
+}
+
+size_t ScoreSession::Process(string_view data, string &output, size_t outputLimit, uint64_t receivedAt)
+{
+	const char *text = data.data();
+	size_t size = data.size();
+	size_t position = 0;
+	while ((position < size) && (output.size() < outputLimit))
+	{
+		if (text[position] == '\0')
+		{
+			if (size - position < FrameHeaderSize)
+				break;
+			size_t length = 0;
+			for (size_t n = 0; n < FrameHeaderSize; n++)
+				length = (length << 8) | static_cast<unsigned char>(text[position + n]);
+			if (length > MaxRequestSize)
+				return string_view::npos;
+			if (size - position - FrameHeaderSize < length)
+				break;
+			Answer(data.substr(position + FrameHeaderSize, length), output, true);
+			position += FrameHeaderSize + length;
+		}
+		else
+		{
+			//a line may be MaxRequestSize bytes before its "\r\n"
+			size_t window = min(size - position, MaxRequestSize + 2);
+			const char *lineBreak = static_cast<const char*>(memchr(text + position, '\n', window));
+			if (!lineBreak)
+			{
+				if (window == MaxRequestSize + 2)
+					return string_view::npos;
+				break;
+			}
+			string_view line(text + position, lineBreak - text - position);
+			if (!line.empty() && (line.back() == '\r'))
+				line.remove_suffix(1);
+			if (line.size() > MaxRequestSize)
+				return string_view::npos;
+			Answer(line, output, false);
+			position = lineBreak - text + 1;
+		}
+		if (_stats)
+			_stats->latency.Add(GetSteadyNanoseconds() - receivedAt);
+	}
+	return position;
+}
+
+uint64_t GetSteadyNanoseconds()
+{
+	return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+}
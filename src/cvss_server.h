@@ -0,0 +1,91 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_SERVER_H_
+#define HAVE_CVSS_SERVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class EnvironmentalProfile;
+class ScoreCache;
+
+//request protocol of cvssd, kept apart from its sockets so any transport (or a test) can drive it. A
+//connection carries pipelined requests, answered in order, each one either
+//  a line: the vector, ended by "\n" or "\r\n"; answered with a line
+//  a frame: a 4-byte big-endian length, then that many bytes of vector; answered with a frame
+//Lengths are at most MaxRequestSize, so a frame always starts with a zero byte, which no line can. An answer
+//is the selected scores separated by tabs, or "error\t" and the parse error. The request "STATS" is answered
+//with the server's counters (ServerStats::Format())
+const size_t MaxRequestSize = 4096;
+const size_t FrameHeaderSize = 4;
+
+//request latencies in buckets of 1/8 of a power of two (12.5% resolution) from 1 ns to about 18 minutes
+struct LatencyHistogram
+{
+	static const size_t SubBuckets = 8;
+	static const size_t Buckets = 40 * SubBuckets;
+
+	uint64_t counts[Buckets] = {};
+
+	void Add(uint64_t nanoseconds);
+	void Merge(LatencyHistogram const& other);
+
+	uint64_t GetCount() const;
+	uint64_t GetPercentile(double percentile) const; //upper bound, in ns, of the bucket holding that percentile; 0 when empty
+};
+
+struct ServerStats
+{
+	uint64_t connections = 0; //accepted so far
+	uint64_t requests = 0;
+	uint64_t errors = 0; //requests whose vector did not parse
+	LatencyHistogram latency; //from reading a request to queuing its answer
+
+	std::string Format() const; //one line: "requests N\terrors N\tconnections N\tp50_ns N\tp99_ns N"
+};
+
+//one connection's side of the protocol; it only appends to the caller's output buffer, so a connection that
+//reuses its buffers allocates nothing per request
+class ScoreSession
+{
+	private:
+		bool _baseScore;
+		bool _temporalScore;
+		bool _environmentalScore;
+		ScoreCache *_cache;
+		EnvironmentalProfile const *_profile;
+		ServerStats *_stats;
+
+		void Answer(std::string_view request, std::string &output, bool frame);
+
+	public:
+		ScoreSession(bool baseScore, bool temporalScore, bool environmentalScore, ScoreCache *cache = nullptr, EnvironmentalProfile const *profile = nullptr, ServerStats *stats = nullptr); //no scores selected means base only, as in the CLI
+
+		//answers the complete requests at the front of data, appending to output until it holds outputLimit
+		//bytes; returns the bytes consumed, or npos if a request is longer than MaxRequestSize. receivedAt is
+		//the steady_clock time, in ns, at which data was read
+		size_t Process(std::string_view data, std::string &output, size_t outputLimit, uint64_t receivedAt);
+};
+
+uint64_t GetSteadyNanoseconds(); //steady_clock::now() in ns, for receivedAt
+
+#endif
@@ -0,0 +1,224 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+#ifdef CVSS_INSTRUMENTATION
+namespace
+{
+	//counters of one thread; only the owner writes them, so relaxed loads and stores are enough
+	//and snapshots from other threads still read whole values
+	struct ThreadStats
+	{
+		atomic<uint64_t> histogram[StageCount][StatsBuckets] = {};
+		atomic<uint64_t> nanoseconds[StageCount] = {};
+		atomic<uint64_t> errors[ParseErrorCount] = {};
+		atomic<uint64_t> versions[CVSSVersionCount] = {};
+
+		ThreadStats();
+		~ThreadStats();
+	};
+
+	void Add(atomic<uint64_t> &counter, uint64_t value)
+	{
+		counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+	}
+
+	void AddTo(StatsSnapshot &totals, ThreadStats const& stats)
+	{
+		for (size_t stage = 0; stage < StageCount; stage++)
+		{
+			for (size_t bucket = 0; bucket < StatsBuckets; bucket++)
+			{
+				uint64_t count = stats.histogram[stage][bucket].load(memory_order_relaxed);
+				totals.stages[stage].histogram[bucket] += count;
+				totals.stages[stage].count += count;
+			}
+			totals.stages[stage].nanoseconds += stats.nanoseconds[stage].load(memory_order_relaxed);
+		}
+		for (size_t error = 0; error < ParseErrorCount; error++)
+			totals.errors[error] += stats.errors[error].load(memory_order_relaxed);
+		for (size_t version = 0; version < CVSSVersionCount; version++)
+			totals.versions[version] += stats.versions[version].load(memory_order_relaxed);
+	}
+
+	//live threads register their counters; exiting threads fold theirs into retired
+	mutex registryLock;
+	vector<ThreadStats*> registry;
+	StatsSnapshot retired;
+
+	ThreadStats::ThreadStats()
+	{
+		lock_guard<mutex> guard(registryLock);
+		registry.push_back(this);
+	}
+
+	ThreadStats::~ThreadStats()
+	{
+		lock_guard<mutex> guard(registryLock);
+		AddTo(retired, *this);
+		registry.erase(find(registry.begin(), registry.end(), this));
+	}
+
+	thread_local ThreadStats local;
+
+	size_t GetBucket(uint64_t nanoseconds)
+	{
+		size_t bucket = 0;
+		while ((nanoseconds >>= 1) && (bucket + 1 < StatsBuckets))
+			bucket++;
+		return bucket;
+	}
+}
+#endif
+
+uint64_t StageStats::GetPercentile(double percentile) const
+{
+	if (count == 0)
+		return 0;
+	uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count);
+	uint64_t seen = 0;
+	for (size_t bucket = 0; bucket < StatsBuckets; bucket++)
+	{
+		seen += histogram[bucket];
+		if (seen > rank)
+			return uint64_t(1) << (bucket + 1);
+	}
+	return uint64_t(1) << StatsBuckets;
+}
+
+bool StatsEnabled()
+{
+#ifdef CVSS_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+}
+
+StatsSnapshot GetStats()
+{
+	StatsSnapshot ret;
+#ifdef CVSS_INSTRUMENTATION
+	lock_guard<mutex> guard(registryLock);
+	ret = retired;
+	for (ThreadStats const *stats : registry)
+		AddTo(ret, *stats);
+#endif
+	return ret;
+}
+
+void ResetStats()
+{
+#ifdef CVSS_INSTRUMENTATION
+	lock_guard<mutex> guard(registryLock);
+	retired = StatsSnapshot();
+	for (ThreadStats *stats : registry)
+	{
+		for (size_t stage = 0; stage < StageCount; stage++)
+		{
+			for (size_t bucket = 0; bucket < StatsBuckets; bucket++)
+				stats->histogram[stage][bucket].store(0, memory_order_relaxed);
+			stats->nanoseconds[stage].store(0, memory_order_relaxed);
+		}
+		for (size_t error = 0; error < ParseErrorCount; error++)
+			stats->errors[error].store(0, memory_order_relaxed);
+		for (size_t version = 0; version < CVSSVersionCount; version++)
+			stats->versions[version].store(0, memory_order_relaxed);
+	}
+#endif
+}
+
+void RecordStage(Stage stage, uint64_t nanoseconds)
+{
+#ifdef CVSS_INSTRUMENTATION
+	Add(local.histogram[static_cast<size_t>(stage)][GetBucket(nanoseconds)], 1);
+	Add(local.nanoseconds[static_cast<size_t>(stage)], nanoseconds);
+#else
+	(void)stage;
+	(void)nanoseconds;
+#endif
+}
+
+void RecordParse(CVSSVersion version, ParseError error)
+{
+#ifdef CVSS_INSTRUMENTATION
+	if (error == ParseError::None)
+		Add(local.versions[static_cast<size_t>(version)], 1);
+	else
+		Add(local.errors[static_cast<size_t>(error)], 1);
+#else
+	(void)version;
+	(void)error;
+#endif
+}
+
+const char *StageString(Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::Read:
+		return "read";
+	case Stage::Parse:
+		return "parse";
+	case Stage::Score:
+		return "score";
+	case Stage::Format:
+		return "format";
+	case Stage::Write:
+		return "write";
+	}
+	return "";
+}
+
+//metric keys of the errors, in ParseError order
+static const char *ErrorMetrics[] = { "", "version", "component", "AV", "AC", "PR", "UI", "S", "C", "I", "A", "E", "RL", "RC", "CR", "IR", "AR", "MAV", "MAC", "MPR", "MUI", "MS", "MC", "MI", "MA", "AT", "VC", "VI", "VA", "SC", "SI", "SA", "MAT", "MVC", "MVI", "MVA", "MSC", "MSI", "MSA", "S (4.0)", "AU", "R", "V", "RE", "U", "Au", "CDP", "TD" };
+static_assert(sizeof(ErrorMetrics) / sizeof(ErrorMetrics[0]) == ParseErrorCount, "every ParseError needs a metric key");
+
+string FormatStats(StatsSnapshot const& stats)
+{
+	string ret = "stage\tcount\tmean ns\tp50 ns\tp99 ns\ttotal ns\n";
+	for (size_t stage = 0; stage < StageCount; stage++)
+	{
+		StageStats const& s = stats.stages[stage];
+		ret += StageString(static_cast<Stage>(stage));
+		ret += '\t' + to_string(s.count);
+		ret += '\t' + to_string(s.count ? s.nanoseconds / s.count : 0);
+		ret += "\t<" + to_string(s.GetPercentile(50));
+		ret += "\t<" + to_string(s.GetPercentile(99));
+		ret += '\t' + to_string(s.nanoseconds) + '\n';
+	}
+	ret += "version\tcount\n";
+	ret += "2.0\t" + to_string(stats.versions[static_cast<size_t>(CVSSVersion::V2_0)]) + '\n';
+	ret += "3.0\t" + to_string(stats.versions[static_cast<size_t>(CVSSVersion::V3_0)]) + '\n';
+	ret += "3.1\t" + to_string(stats.versions[static_cast<size_t>(CVSSVersion::V3_1)]) + '\n';
+	ret += "4.0\t" + to_string(stats.versions[static_cast<size_t>(CVSSVersion::V4_0)]) + '\n';
+	ret += "error\tcount\n";
+	for (size_t error = 1; error < ParseErrorCount; error++)
+	{
+		if (stats.errors[error])
+			ret += string(ErrorMetrics[error]) + '\t' + to_string(stats.errors[error]) + '\n';
+	}
+	return ret;
+}
@@ -0,0 +1,139 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_STATS_H_
+#define HAVE_CVSS_STATS_H_
+
+#include "cvss_vector.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//optional hot-path instrumentation, compiled in with -DCVSS_INSTRUMENTATION=ON; without it the
+//CVSS_STAGE_TIMER and InstrumentedParseVector() cost nothing and every snapshot is empty
+enum class Stage {
+	Read, //splitting batch input into lines
+	Parse, //ParseVector()
+	Score, //scoring a parsed vector
+	Format, //writing scores as text or binary records
+	Write //copying formatted output to the stream
+};
+
+const size_t StageCount = static_cast<size_t>(Stage::Write) + 1;
+const size_t StatsBuckets = 40; //bucket k counts durations of [2^k, 2^(k + 1)) ns; bucket 0 also holds 0 ns
+const size_t ParseErrorCount = static_cast<size_t>(ParseError::TargetDistribution) + 1;
+const size_t CVSSVersionCount = static_cast<size_t>(CVSSVersion::V2_0) + 1;
+
+struct StageStats
+{
+	uint64_t count = 0;
+	uint64_t nanoseconds = 0;
+	uint64_t histogram[StatsBuckets] = {};
+
+	uint64_t GetPercentile(double percentile) const; //upper bound, in ns, of the bucket holding that percentile
+};
+
+struct StatsSnapshot
+{
+	StageStats stages[StageCount];
+	uint64_t errors[ParseErrorCount] = {}; //indexed by ParseError; ParseError::None is unused
+	uint64_t versions[CVSSVersionCount] = {}; //successfully parsed vectors, indexed by CVSSVersion
+};
+
+bool StatsEnabled(); //whether the library was built with CVSS_INSTRUMENTATION
+StatsSnapshot GetStats(); //totals over every thread so far
+void ResetStats(); //only exact while nothing is being scored
+std::string FormatStats(StatsSnapshot const& stats);
+const char *StageString(Stage stage);
+
+void RecordStage(Stage stage, uint64_t nanoseconds);
+void RecordParse(CVSSVersion version, ParseError error); //counts the version, or the error
+
+//times the enclosing scope
+class StageTimer
+{
+	private:
+		Stage _stage;
+		std::chrono::steady_clock::time_point _start;
+
+	public:
+		explicit StageTimer(Stage stage) : _stage(stage), _start(std::chrono::steady_clock::now()) {}
+		~StageTimer() { RecordStage(_stage, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count())); }
+		StageTimer(StageTimer const&) = delete;
+		StageTimer &operator=(StageTimer const&) = delete;
+};
+
+#ifdef CVSS_INSTRUMENTATION
+#define CVSS_STAGE_TIMER(stage) StageTimer cvssStageTimer(stage)
+#else
+#define CVSS_STAGE_TIMER(stage) ((void)0)
+#endif
+
+//ParseVector(), timed and counted when instrumentation is compiled in
+inline ParsedVector InstrumentedParseVector(std::string_view data)
+{
+#ifdef CVSS_INSTRUMENTATION
+	ParsedVector ret;
+	{
+		StageTimer timer(Stage::Parse);
+		ret = ParseVector(data);
+	}
+	RecordParse(ret.version, ret.error);
+	return ret;
+#else
+	return ParseVector(data);
+#endif
+}
+
+//same for ParseVector4()
+inline ParsedVector4 InstrumentedParseVector4(std::string_view data)
+{
+#ifdef CVSS_INSTRUMENTATION
+	ParsedVector4 ret;
+	{
+		StageTimer timer(Stage::Parse);
+		ret = ParseVector4(data);
+	}
+	RecordParse(CVSSVersion::V4_0, ret.error);
+	return ret;
+#else
+	return ParseVector4(data);
+#endif
+}
+
+//same for ParseVector2()
+inline ParsedVector2 InstrumentedParseVector2(std::string_view data)
+{
+#ifdef CVSS_INSTRUMENTATION
+	ParsedVector2 ret;
+	{
+		StageTimer timer(Stage::Parse);
+		ret = ParseVector2(data);
+	}
+	RecordParse(CVSSVersion::V2_0, ret.error);
+	return ret;
+#else
+	return ParseVector2(data);
+#endif
+}
+
+#endif
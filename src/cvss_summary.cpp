@@ -0,0 +1,309 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_summary.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+namespace
+{
+	//first row of each grammar in SummaryMetrics; rows follow in the order of the vector's fields
+	const size_t FirstMetric2 = 0;
+	const size_t FirstMetric3 = 6;
+	const size_t FirstMetric4 = 14;
+	static_assert((SummaryMetrics[FirstMetric2].grammar == VectorGrammar::V2) && (SummaryMetrics[FirstMetric3 - 1].grammar == VectorGrammar::V2), "2.0 summary rows moved");
+	static_assert((SummaryMetrics[FirstMetric3].grammar == VectorGrammar::V3) && (SummaryMetrics[FirstMetric4 - 1].grammar == VectorGrammar::V3), "3.x summary rows moved");
+	static_assert((SummaryMetrics[FirstMetric4].grammar == VectorGrammar::V4) && (SummaryMetricCount - FirstMetric4 == 11), "4.0 summary rows moved");
+
+	template<typename T> size_t Value(T value)
+	{
+		return static_cast<size_t>(value);
+	}
+
+	//score in tenths, written the way batch output writes it
+	string TenthsString(size_t tenths)
+	{
+		string ret = to_string(tenths / 10);
+		if (tenths % 10 != 0)
+		{
+			ret.push_back('.');
+			ret.push_back(static_cast<char>('0' + (tenths % 10)));
+		}
+		return ret;
+	}
+
+	string ScoreString(float score)
+	{
+		return TenthsString(static_cast<size_t>(lround(score * 10.0)));
+	}
+
+	void AppendHistogram(string &ret, const char *name, ScoreHistogram const& histogram)
+	{
+		char mean[32];
+		snprintf(mean, sizeof(mean), "%.2f", histogram.GetMean());
+		ret += name;
+		ret += '\t' + to_string(histogram.GetCount());
+		ret += '\t';
+		ret += mean;
+		const double percentiles[] = { 0, 50, 90, 99, 100 };
+		for (double percentile : percentiles)
+			ret += '\t' + ScoreString(histogram.GetPercentile(percentile));
+		ret += '\n';
+	}
+
+	void AppendSeverities(string &ret, const char *name, ScoreHistogram const& histogram)
+	{
+		ret += name;
+		for (size_t severity = 0; severity < SeverityCount; severity++)
+			ret += '\t' + to_string(histogram.GetSeverityCount(static_cast<Severity>(severity)));
+		ret += '\n';
+	}
+}
+
+void ScoreHistogram::Add(float score)
+{
+	tenths[lround(score * 10.0)]++;
+}
+
+void ScoreHistogram::Merge(ScoreHistogram const& other)
+{
+	for (size_t n = 0; n <= 100; n++)
+		tenths[n] += other.tenths[n];
+}
+
+uint64_t ScoreHistogram::GetCount() const
+{
+	uint64_t ret = 0;
+	for (size_t n = 0; n <= 100; n++)
+		ret += tenths[n];
+	return ret;
+}
+
+double ScoreHistogram::GetMean() const
+{
+	uint64_t count = 0;
+	uint64_t total = 0;
+	for (size_t n = 0; n <= 100; n++)
+	{
+		count += tenths[n];
+		total += tenths[n] * n;
+	}
+	return count ? static_cast<double>(total) / count / 10.0 : 0;
+}
+
+float ScoreHistogram::GetPercentile(double percentile) const
+{
+	uint64_t count = GetCount();
+	if (count == 0)
+		return 0;
+	uint64_t rank = static_cast<uint64_t>(ceil(percentile / 100.0 * count));
+	if (rank == 0)
+		rank = 1;
+	uint64_t seen = 0;
+	for (size_t n = 0; n <= 100; n++)
+	{
+		seen += tenths[n];
+		if (seen >= rank)
+			return n / 10.0f;
+	}
+	return 10.0f;
+}
+
+uint64_t ScoreHistogram::GetSeverityCount(Severity severity) const
+{
+	uint64_t ret = 0;
+	for (size_t n = 0; n <= 100; n++)
+	{
+		if (GetSeverity(n / 10.0f) == severity)
+			ret += tenths[n];
+	}
+	return ret;
+}
+
+void ScoreSummary::AddScores(ScoreResult const& result)
+{
+	_base.Add(result.base);
+	_temporal.Add(result.temporal);
+	_environmental.Add(result.environmental);
+	_versions[static_cast<size_t>(result.version)]++;
+}
+
+void ScoreSummary::Add(ScoreResult const& result)
+{
+	if (result.error != ParseError::None)
+		_errors++;
+	else
+		AddScores(result);
+}
+
+void ScoreSummary::Add(ParsedVector const& v, ScoreResult const& result)
+{
+	Add(result);
+	if (result.error != ParseError::None)
+		return;
+	AddMetric(FirstMetric3, Value(v.av));
+	AddMetric(FirstMetric3 + 1, Value(v.ac));
+	AddMetric(FirstMetric3 + 2, Value(v.pr));
+	AddMetric(FirstMetric3 + 3, Value(v.ui));
+	AddMetric(FirstMetric3 + 4, Value(v.s));
+	AddMetric(FirstMetric3 + 5, Value(v.c));
+	AddMetric(FirstMetric3 + 6, Value(v.i));
+	AddMetric(FirstMetric3 + 7, Value(v.a));
+}
+
+void ScoreSummary::Add(ParsedVector2 const& v, ScoreResult const& result)
+{
+	Add(result);
+	if (result.error != ParseError::None)
+		return;
+	AddMetric(FirstMetric2, Value(v.av));
+	AddMetric(FirstMetric2 + 1, Value(v.ac));
+	AddMetric(FirstMetric2 + 2, Value(v.au));
+	AddMetric(FirstMetric2 + 3, Value(v.c));
+	AddMetric(FirstMetric2 + 4, Value(v.i));
+	AddMetric(FirstMetric2 + 5, Value(v.a));
+}
+
+void ScoreSummary::Add(ParsedVector4 const& v, ScoreResult const& result)
+{
+	Add(result);
+	if (result.error != ParseError::None)
+		return;
+	AddMetric(FirstMetric4, Value(v.av));
+	AddMetric(FirstMetric4 + 1, Value(v.ac));
+	AddMetric(FirstMetric4 + 2, Value(v.at));
+	AddMetric(FirstMetric4 + 3, Value(v.pr));
+	AddMetric(FirstMetric4 + 4, Value(v.ui));
+	AddMetric(FirstMetric4 + 5, Value(v.vc));
+	AddMetric(FirstMetric4 + 6, Value(v.vi));
+	AddMetric(FirstMetric4 + 7, Value(v.va));
+	AddMetric(FirstMetric4 + 8, Value(v.sc));
+	AddMetric(FirstMetric4 + 9, Value(v.si));
+	AddMetric(FirstMetric4 + 10, Value(v.sa));
+}
+
+void ScoreSummary::Merge(ScoreSummary const& other)
+{
+	_base.Merge(other._base);
+	_temporal.Merge(other._temporal);
+	_environmental.Merge(other._environmental);
+	for (size_t n = 0; n < CVSSVersionCount; n++)
+		_versions[n] += other._versions[n];
+	_errors += other._errors;
+	for (size_t metric = 0; metric < SummaryMetricCount; metric++)
+		for (size_t value = 0; value < SummaryValueCount; value++)
+			_metrics[metric][value] += other._metrics[metric][value];
+}
+
+uint64_t ScoreSummary::GetCount() const
+{
+	uint64_t ret = 0;
+	for (size_t n = 0; n < CVSSVersionCount; n++)
+		ret += _versions[n];
+	return ret;
+}
+
+uint64_t ScoreSummary::GetErrors() const
+{
+	return _errors;
+}
+
+uint64_t ScoreSummary::GetVersionCount(CVSSVersion version) const
+{
+	return _versions[static_cast<size_t>(version)];
+}
+
+uint64_t ScoreSummary::GetMetricCount(size_t metric, size_t value) const
+{
+	return _metrics[metric][value];
+}
+
+ScoreResult Summarize(string_view vector, ScoreSummary &summary, EnvironmentalProfile const *profile)
+{
+	ScoreResult ret;
+	VectorGrammar grammar = GetVectorGrammar(vector);
+	if (grammar == VectorGrammar::V4)
+	{
+		ParsedVector4 v = InstrumentedParseVector4(vector);
+		ret = Score(v);
+		summary.Add(v, ret);
+	}
+	else if (grammar == VectorGrammar::V2)
+	{
+		ParsedVector2 v = InstrumentedParseVector2(vector);
+		ret = Score(v);
+		summary.Add(v, ret);
+	}
+	else
+	{
+		ParsedVector v = InstrumentedParseVector(vector);
+		ret = profile ? profile->Score(v) : Score(v);
+		summary.Add(v, ret);
+	}
+	return ret;
+}
+
+string FormatSummary(ScoreSummary const& summary, bool baseScore, bool temporalScore, bool environmentalScore)
+{
+	string ret = "score\tcount\tmean\tmin\tp50\tp90\tp99\tmax\n";
+	if (baseScore)
+		AppendHistogram(ret, "base", summary.GetBase());
+	if (temporalScore)
+		AppendHistogram(ret, "temporal", summary.GetTemporal());
+	if (environmentalScore)
+		AppendHistogram(ret, "environmental", summary.GetEnvironmental());
+
+	ret += "severity";
+	for (size_t severity = 0; severity < SeverityCount; severity++)
+		ret += '\t' + string(SeverityString(static_cast<Severity>(severity)));
+	ret += '\n';
+	if (baseScore)
+		AppendSeverities(ret, "base", summary.GetBase());
+	if (temporalScore)
+		AppendSeverities(ret, "temporal", summary.GetTemporal());
+	if (environmentalScore)
+		AppendSeverities(ret, "environmental", summary.GetEnvironmental());
+
+	ret += "version\tcount\n";
+	ret += "2.0\t" + to_string(summary.GetVersionCount(CVSSVersion::V2_0)) + '\n';
+	ret += "3.0\t" + to_string(summary.GetVersionCount(CVSSVersion::V3_0)) + '\n';
+	ret += "3.1\t" + to_string(summary.GetVersionCount(CVSSVersion::V3_1)) + '\n';
+	ret += "4.0\t" + to_string(summary.GetVersionCount(CVSSVersion::V4_0)) + '\n';
+	ret += "errors\t" + to_string(summary.GetErrors()) + '\n';
+
+	//metric values of the grammars that scored anything, e.g. "3.x AV N 1234"
+	uint64_t grammarCounts[] = {
+		summary.GetVersionCount(CVSSVersion::V2_0),
+		summary.GetVersionCount(CVSSVersion::V3_0) + summary.GetVersionCount(CVSSVersion::V3_1),
+		summary.GetVersionCount(CVSSVersion::V4_0)
+	};
+	const char *grammarNames[] = { "2.0", "3.x", "4.0" };
+	ret += "metric\tvalue\tcount\n";
+	for (size_t metric = 0; metric < SummaryMetricCount; metric++)
+	{
+		size_t grammar = static_cast<size_t>(SummaryMetrics[metric].grammar);
+		if (grammarCounts[grammar] == 0)
+			continue;
+		for (size_t value = 0; SummaryMetrics[metric].values[value] != '\0'; value++)
+			ret += string(grammarNames[grammar]) + ' ' + SummaryMetrics[metric].key + '\t' + SummaryMetrics[metric].values[value] + '\t' + to_string(summary.GetMetricCount(metric, value)) + '\n';
+	}
+	return ret;
+}
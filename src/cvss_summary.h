@@ -0,0 +1,108 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_SUMMARY_H_
+#define HAVE_CVSS_SUMMARY_H_
+
+#include "cvss_profile.h"
+#include "cvss_score.h"
+#include "cvss_stats.h"
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+const size_t SeverityCount = static_cast<size_t>(Severity::Critical) + 1;
+
+//exact distribution of one score; scores only take 101 values in tenths, so this is a counter per value
+struct ScoreHistogram
+{
+	uint64_t tenths[101] = {}; //vectors per rounded score, in tenths
+
+	void Add(float score); //score must already be rounded
+	void Merge(ScoreHistogram const& other);
+
+	uint64_t GetCount() const;
+	double GetMean() const; //0 when empty
+	float GetPercentile(double percentile) const; //nearest rank: the lowest score at least that share of the vectors are at or below
+	uint64_t GetSeverityCount(Severity severity) const;
+};
+
+//base metrics counted per value; one row per metric of each grammar, values in the order of their enum
+struct SummaryMetric
+{
+	VectorGrammar grammar;
+	const char *key;
+	const char *values; //one letter per value
+};
+
+constexpr SummaryMetric SummaryMetrics[] = {
+	{ VectorGrammar::V2, "AV", "LAN" }, { VectorGrammar::V2, "AC", "HML" }, { VectorGrammar::V2, "Au", "MSN" },
+	{ VectorGrammar::V2, "C", "NPC" }, { VectorGrammar::V2, "I", "NPC" }, { VectorGrammar::V2, "A", "NPC" },
+	{ VectorGrammar::V3, "AV", "NALP" }, { VectorGrammar::V3, "AC", "LH" }, { VectorGrammar::V3, "PR", "NLH" }, { VectorGrammar::V3, "UI", "NR" },
+	{ VectorGrammar::V3, "S", "UC" }, { VectorGrammar::V3, "C", "HLN" }, { VectorGrammar::V3, "I", "HLN" }, { VectorGrammar::V3, "A", "HLN" },
+	{ VectorGrammar::V4, "AV", "NALP" }, { VectorGrammar::V4, "AC", "LH" }, { VectorGrammar::V4, "AT", "NP" }, { VectorGrammar::V4, "PR", "NLH" },
+	{ VectorGrammar::V4, "UI", "NPA" }, { VectorGrammar::V4, "VC", "HLN" }, { VectorGrammar::V4, "VI", "HLN" }, { VectorGrammar::V4, "VA", "HLN" },
+	{ VectorGrammar::V4, "SC", "HLN" }, { VectorGrammar::V4, "SI", "HLN" }, { VectorGrammar::V4, "SA", "HLN" }
+};
+
+const size_t SummaryMetricCount = sizeof(SummaryMetrics) / sizeof(SummaryMetrics[0]);
+const size_t SummaryValueCount = 4; //most values of any summarised metric
+
+//constant-size accumulator of a batch: score histograms, versions, errors and base metric values; each worker
+//fills its own and Merge() adds them up, in any order
+class ScoreSummary
+{
+	private:
+		ScoreHistogram _base;
+		ScoreHistogram _temporal;
+		ScoreHistogram _environmental;
+		uint64_t _versions[CVSSVersionCount] = {};
+		uint64_t _errors = 0;
+		uint64_t _metrics[SummaryMetricCount][SummaryValueCount] = {};
+
+		void AddScores(ScoreResult const& result);
+		void AddMetric(size_t metric, size_t value) { _metrics[metric][value]++; }
+
+	public:
+		void Add(ScoreResult const& result); //scores and version only; an error is counted instead
+		void Add(ParsedVector const& vector, ScoreResult const& result); //also counts the base metric values
+		void Add(ParsedVector2 const& vector, ScoreResult const& result);
+		void Add(ParsedVector4 const& vector, ScoreResult const& result);
+		void Merge(ScoreSummary const& other);
+
+		uint64_t GetCount() const; //scored vectors
+		uint64_t GetErrors() const;
+		uint64_t GetVersionCount(CVSSVersion version) const;
+		uint64_t GetMetricCount(size_t metric, size_t value) const; //metric indexes SummaryMetrics
+		ScoreHistogram const& GetBase() const { return _base; }
+		ScoreHistogram const& GetTemporal() const { return _temporal; }
+		ScoreHistogram const& GetEnvironmental() const { return _environmental; }
+};
+
+//parse and score one vector into the summary with the grammar it calls for, overlaying a profile on 3.x vectors;
+//the result is returned so errors can be reported
+ScoreResult Summarize(std::string_view vector, ScoreSummary &summary, EnvironmentalProfile const *profile = nullptr);
+
+//tab-separated report of the selected scores, with the metric values of every grammar that was seen
+std::string FormatSummary(ScoreSummary const& summary, bool baseScore = true, bool temporalScore = false, bool environmentalScore = false);
+
+#endif
@@ -0,0 +1,320 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_table.h"
+#include "cvss_2_engine.h"
+#include "cvss_3_engine.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+namespace
+{
+	//tables are padded so vector gathers may read a full 32-bit word at the last entry
+	const size_t GatherPadding = 3;
+
+	struct TenthsTable
+	{
+		float score[101]; //score for each value in tenths, rounded the way ceil(x * 10.0) / 10.0 is
+
+		constexpr TenthsTable() : score()
+		{
+			for (int n = 0; n <= 100; n++)
+				score[n] = n / 10.0;
+		}
+	};
+
+	struct ScoreTables
+	{
+		uint8_t base[BaseTableSize + GatherPadding]; //rounded base score in tenths
+		uint8_t temporal[BaseTableSize * TemporalTableSize + GatherPadding]; //rounded temporal score in tenths
+
+		ScoreTables();
+	};
+
+	struct EnvironmentalTable
+	{
+		uint8_t environmental[VersionTableSize * BaseTableSize * RequirementTableSize + GatherPadding]; //rounded environmental score in tenths
+
+		EnvironmentalTable();
+	};
+
+	struct ScoreTables2
+	{
+		uint8_t base[BaseTableSize2 * RequirementTableSize]; //rounded AdjustedBase in tenths
+		uint8_t temporal[101 * TemporalTableSize]; //rounded temporal score in tenths, by base score in tenths
+		uint8_t environmental[101 * DamageTableSize2]; //rounded environmental score in tenths, by AdjustedTemporal in tenths
+
+		ScoreTables2();
+	};
+
+	constexpr TenthsTable tenthsTable;
+
+	uint8_t ToTenths(double score)
+	{
+		return static_cast<uint8_t>(lround(max(score, 0.0) * 10.0));
+	}
+
+	ScoreTables::ScoreTables() :
+		base(),
+		temporal()
+	{
+		//temporal multipliers come straight from the shared 3.x weights
+		typedef CVSS_3_Engine<CVSSVersion::V3_1> Engine;
+		float temporalFactor[TemporalTableSize][3];
+		for (size_t t = 0; t < TemporalTableSize; t++)
+		{
+			ExploitCodeMaturity e;
+			RemediationLevel rl;
+			ReportConfidence rc;
+			GetTemporalMetrics(t, e, rl, rc);
+			temporalFactor[t][0] = Engine::ExploitCodeMaturityWeight(e);
+			temporalFactor[t][1] = Engine::RemediationLevelWeight(rl);
+			temporalFactor[t][2] = Engine::ReportConfidenceWeight(rc);
+		}
+
+		//base and temporal scores are the same for 3.0 and 3.1
+		ParsedVector v;
+		Engine engine;
+		for (size_t b = 0; b < BaseTableSize; b++)
+		{
+			GetBaseMetrics(b, v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a);
+			engine.Reset(v);
+			base[b] = ToTenths(engine.GetBaseScore());
+
+			float unrounded = engine.GetBaseScore(false, false);
+			for (size_t t = 0; t < TemporalTableSize; t++)
+				temporal[b * TemporalTableSize + t] = ToTenths(Engine::TemporalScore(unrounded, temporalFactor[t][0], temporalFactor[t][1], temporalFactor[t][2], true));
+		}
+	}
+
+	//score the effective metrics with no modified flags set and every requirement weight
+	template<CVSSVersion V> void BuildEnvironmentalTable(uint8_t *environmental)
+	{
+		const Requirement weights[3] = { Requirement::Low, Requirement::Medium, Requirement::High };
+		ParsedVector v;
+		CVSS_3_Engine<V> engine;
+		for (size_t b = 0; b < BaseTableSize; b++)
+		{
+			GetBaseMetrics(b, v.av, v.ac, v.pr, v.ui, v.s, v.c, v.i, v.a);
+			for (Requirement cr : weights)
+				for (Requirement ir : weights)
+					for (Requirement ar : weights)
+					{
+						v.cr = cr;
+						v.ir = ir;
+						v.ar = ar;
+						engine.Reset(v);
+						environmental[b * RequirementTableSize + GetRequirementIndex(cr, ir, ar)] = ToTenths(engine.GetEnvironmentalScore());
+					}
+		}
+	}
+
+	EnvironmentalTable::EnvironmentalTable() :
+		environmental()
+	{
+		BuildEnvironmentalTable<CVSSVersion::V3_0>(environmental + static_cast<size_t>(CVSSVersion::V3_0) * BaseTableSize * RequirementTableSize);
+		BuildEnvironmentalTable<CVSSVersion::V3_1>(environmental + static_cast<size_t>(CVSSVersion::V3_1) * BaseTableSize * RequirementTableSize);
+	}
+
+	ScoreTables2::ScoreTables2() :
+		base(),
+		temporal(),
+		environmental()
+	{
+		const Requirement weights[3] = { Requirement::Low, Requirement::Medium, Requirement::High };
+		Vector2Metrics v;
+		for (size_t b = 0; b < BaseTableSize2; b++)
+		{
+			v.a = static_cast<Impact2>(b % 3);
+			v.i = static_cast<Impact2>(b / 3 % 3);
+			v.c = static_cast<Impact2>(b / 9 % 3);
+			v.au = static_cast<Authentication>(b / 27 % 3);
+			v.ac = static_cast<AccessComplexity>(b / 81 % 3);
+			v.av = static_cast<AccessVector>(b / 243);
+			for (Requirement cr : weights)
+				for (Requirement ir : weights)
+					for (Requirement ar : weights)
+					{
+						v.cr = cr;
+						v.ir = ir;
+						v.ar = ar;
+						base[b * RequirementTableSize + GetRequirementIndex(cr, ir, ar)] = ToTenths(CVSS_2_Engine(v).GetBaseScore(true));
+					}
+		}
+
+		typedef CVSS_2_Engine Engine;
+		for (size_t tenths = 0; tenths <= 100; tenths++)
+		{
+			for (size_t t = 0; t < TemporalTableSize; t++)
+			{
+				Exploitability e = static_cast<Exploitability>(t / 20);
+				RemediationLevel2 rl = static_cast<RemediationLevel2>(t / 4 % 5);
+				ReportConfidence2 rc = static_cast<ReportConfidence2>(t % 4);
+				temporal[tenths * TemporalTableSize + t] = ToTenths(Engine::Round(tenths / 10.0 * Engine::TemporalWeight(e, rl, rc)));
+			}
+			for (size_t d = 0; d < DamageTableSize2; d++)
+			{
+				CollateralDamagePotential cdp = static_cast<CollateralDamagePotential>(d / 5);
+				TargetDistribution td = static_cast<TargetDistribution>(d % 5);
+				environmental[tenths * DamageTableSize2 + d] = ToTenths(Engine::Round(Engine::EnvironmentalScore(tenths / 10.0, cdp, td)));
+			}
+		}
+	}
+
+	//built on first use so processes that never score pay nothing at load
+	ScoreTables const& GetScoreTables()
+	{
+		static const ScoreTables tables;
+		return tables;
+	}
+
+	EnvironmentalTable const& GetEnvironmentalTables()
+	{
+		static const EnvironmentalTable tables;
+		return tables;
+	}
+
+	ScoreTables2 const& GetScoreTables2()
+	{
+		static const ScoreTables2 tables;
+		return tables;
+	}
+}
+
+size_t GetBaseIndex(AttackVector av, AttackComplexity ac, PrivilegesRequired pr, UserInteraction ui, Scope s, Impact c, Impact i, Impact a)
+{
+	size_t ret = static_cast<size_t>(av);
+	ret = ret * 2 + static_cast<size_t>(ac);
+	ret = ret * 3 + static_cast<size_t>(pr);
+	ret = ret * 2 + static_cast<size_t>(ui);
+	ret = ret * 2 + static_cast<size_t>(s);
+	ret = ret * 3 + static_cast<size_t>(c);
+	ret = ret * 3 + static_cast<size_t>(i);
+	ret = ret * 3 + static_cast<size_t>(a);
+	return ret;
+}
+
+size_t GetTemporalIndex(ExploitCodeMaturity e, RemediationLevel rl, ReportConfidence rc)
+{
+	return (static_cast<size_t>(e) * 5 + static_cast<size_t>(rl)) * 4 + static_cast<size_t>(rc);
+}
+
+size_t GetBaseIndex(AccessVector av, AccessComplexity ac, Authentication au, Impact2 c, Impact2 i, Impact2 a)
+{
+	size_t ret = static_cast<size_t>(av);
+	ret = ret * 3 + static_cast<size_t>(ac);
+	ret = ret * 3 + static_cast<size_t>(au);
+	ret = ret * 3 + static_cast<size_t>(c);
+	ret = ret * 3 + static_cast<size_t>(i);
+	ret = ret * 3 + static_cast<size_t>(a);
+	return ret;
+}
+
+size_t GetTemporalIndex(Exploitability e, RemediationLevel2 rl, ReportConfidence2 rc)
+{
+	return (static_cast<size_t>(e) * 5 + static_cast<size_t>(rl)) * 4 + static_cast<size_t>(rc);
+}
+
+size_t GetDamageIndex(CollateralDamagePotential cdp, TargetDistribution td)
+{
+	return static_cast<size_t>(cdp) * 5 + static_cast<size_t>(td);
+}
+
+size_t GetRequirementIndex(Requirement cr, Requirement ir, Requirement ar)
+{
+	//Low, Medium (or Not Defined), High
+	auto weight = [](Requirement r) -> size_t { return (r == Requirement::Low) ? 0 : ((r == Requirement::High) ? 2 : 1); };
+	return (weight(cr) * 3 + weight(ir)) * 3 + weight(ar);
+}
+
+void GetBaseMetrics(size_t baseIndex, AttackVector &av, AttackComplexity &ac, PrivilegesRequired &pr, UserInteraction &ui, Scope &s, Impact &c, Impact &i, Impact &a)
+{
+	a = static_cast<Impact>(baseIndex % 3); baseIndex /= 3;
+	i = static_cast<Impact>(baseIndex % 3); baseIndex /= 3;
+	c = static_cast<Impact>(baseIndex % 3); baseIndex /= 3;
+	s = static_cast<Scope>(baseIndex % 2); baseIndex /= 2;
+	ui = static_cast<UserInteraction>(baseIndex % 2); baseIndex /= 2;
+	pr = static_cast<PrivilegesRequired>(baseIndex % 3); baseIndex /= 3;
+	ac = static_cast<AttackComplexity>(baseIndex % 2); baseIndex /= 2;
+	av = static_cast<AttackVector>(baseIndex);
+}
+
+void GetTemporalMetrics(size_t temporalIndex, ExploitCodeMaturity &e, RemediationLevel &rl, ReportConfidence &rc)
+{
+	rc = static_cast<ReportConfidence>(temporalIndex % 4); temporalIndex /= 4;
+	rl = static_cast<RemediationLevel>(temporalIndex % 5); temporalIndex /= 5;
+	e = static_cast<ExploitCodeMaturity>(temporalIndex);
+}
+
+float LookupBaseScore(size_t baseIndex)
+{
+	return tenthsTable.score[GetScoreTables().base[baseIndex]];
+}
+
+float LookupTemporalScore(size_t baseIndex, size_t temporalIndex)
+{
+	return tenthsTable.score[GetScoreTables().temporal[baseIndex * TemporalTableSize + temporalIndex]];
+}
+
+float LookupEnvironmentalScore(CVSSVersion version, size_t modifiedBaseIndex, size_t requirementIndex)
+{
+	return tenthsTable.score[GetEnvironmentalTables().environmental[(static_cast<size_t>(version) * BaseTableSize + modifiedBaseIndex) * RequirementTableSize + requirementIndex]];
+}
+
+uint8_t LookupBaseTenths2(size_t baseIndex, size_t requirementIndex)
+{
+	return GetScoreTables2().base[baseIndex * RequirementTableSize + requirementIndex];
+}
+
+uint8_t LookupTemporalTenths2(uint8_t baseTenths, size_t temporalIndex)
+{
+	assert(baseTenths <= 100);
+	return GetScoreTables2().temporal[baseTenths * TemporalTableSize + temporalIndex];
+}
+
+uint8_t LookupEnvironmentalTenths2(uint8_t adjustedTemporalTenths, size_t damageIndex)
+{
+	assert(adjustedTemporalTenths <= 100);
+	return GetScoreTables2().environmental[adjustedTemporalTenths * DamageTableSize2 + damageIndex];
+}
+
+const float *GetTenthsTable()
+{
+	return tenthsTable.score;
+}
+
+const uint8_t *GetBaseTable()
+{
+	return GetScoreTables().base;
+}
+
+const uint8_t *GetTemporalTable()
+{
+	return GetScoreTables().temporal;
+}
+
+const uint8_t *GetEnvironmentalTable()
+{
+	return GetEnvironmentalTables().environmental;
+}
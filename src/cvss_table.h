@@ -0,0 +1,73 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_TABLE_H_
+#define HAVE_CVSS_TABLE_H_
+
+#include "cvss_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+
+const size_t BaseTableSize = 4 * 2 * 3 * 2 * 2 * 3 * 3 * 3; //AV x AC x PR x UI x S x C x I x A
+const size_t TemporalTableSize = 5 * 5 * 4; //E x RL x RC
+const size_t RequirementTableSize = 3 * 3 * 3; //CR x IR x AR weights (Not Defined weighs the same as Medium)
+const size_t VersionTableSize = 2; //3.0 and 3.1 only disagree on the modified impact of a changed scope
+const size_t BaseTableSize2 = 3 * 3 * 3 * 3 * 3 * 3; //AV x AC x Au x C x I x A of 2.0; its E x RL x RC also has TemporalTableSize values
+const size_t DamageTableSize2 = 6 * 5; //CDP x TD of 2.0
+
+//value a modified metric contributes to environmental scoring
+template<typename T> T GetModifiedValue(T base, Modified<T> const& m)
+{
+	return m.modified ? m.parent : base;
+}
+
+//dense indices into the score tables, built from the metric enums
+size_t GetBaseIndex(AttackVector av, AttackComplexity ac, PrivilegesRequired pr, UserInteraction ui, Scope s, Impact c, Impact i, Impact a);
+size_t GetTemporalIndex(ExploitCodeMaturity e, RemediationLevel rl, ReportConfidence rc);
+size_t GetRequirementIndex(Requirement cr, Requirement ir, Requirement ar);
+size_t GetBaseIndex(AccessVector av, AccessComplexity ac, Authentication au, Impact2 c, Impact2 i, Impact2 a);
+size_t GetTemporalIndex(Exploitability e, RemediationLevel2 rl, ReportConfidence2 rc);
+size_t GetDamageIndex(CollateralDamagePotential cdp, TargetDistribution td);
+void GetBaseMetrics(size_t baseIndex, AttackVector &av, AttackComplexity &ac, PrivilegesRequired &pr, UserInteraction &ui, Scope &s, Impact &c, Impact &i, Impact &a); //inverse of GetBaseIndex()
+void GetTemporalMetrics(size_t temporalIndex, ExploitCodeMaturity &e, RemediationLevel &rl, ReportConfidence &rc); //inverse of GetTemporalIndex()
+
+//rounded scores precomputed on first use; identical to GetBaseScore() and GetTemporalScore() of either 3.x version
+float LookupBaseScore(size_t baseIndex);
+float LookupTemporalScore(size_t baseIndex, size_t temporalIndex);
+//environmental scores only depend on the version and the effective (modified where set, base otherwise) metrics,
+//so modifiedBaseIndex is GetBaseIndex() of those; identical to CVSS_3::GetEnvironmentalScore() for V3_0 and
+//CVSS_3_1::GetEnvironmentalScore() for V3_1
+float LookupEnvironmentalScore(CVSSVersion version, size_t modifiedBaseIndex, size_t requirementIndex);
+
+//2.0 scores chain through their rounded predecessors, so its tables hold tenths and are looked up in turn; identical
+//to CVSS_2_Engine
+uint8_t LookupBaseTenths2(size_t baseIndex, size_t requirementIndex); //AdjustedBase; the Medium requirements give the Base Score
+uint8_t LookupTemporalTenths2(uint8_t baseTenths, size_t temporalIndex); //Temporal Score, or AdjustedTemporal from AdjustedBase
+uint8_t LookupEnvironmentalTenths2(uint8_t adjustedTemporalTenths, size_t damageIndex);
+
+//raw tables for vectorised kernels: scores in tenths, indexed as above (temporal is baseIndex * TemporalTableSize + temporalIndex,
+//environmental is (version * BaseTableSize + modifiedBaseIndex) * RequirementTableSize + requirementIndex); each may be read
+//up to 3 bytes past its end
+const float *GetTenthsTable(); //101 entries, tenths to the float the score getters return
+const uint8_t *GetBaseTable();
+const uint8_t *GetTemporalTable();
+const uint8_t *GetEnvironmentalTable();
+
+#endif
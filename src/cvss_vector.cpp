@@ -0,0 +1,133 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include "cvss_vector.h"
+
+#include <cstdlib>
+
+using namespace std;
+
+const char *ParseErrorString(ParseError error)
+{
+	switch (error)
+	{
+	case ParseError::None:
+		return "No error";
+	case ParseError::UnsupportedVersion:
+		return "Unsupported CVSS version";
+	case ParseError::UnknownComponent:
+		return "Unknown component";
+	case ParseError::AttackVector:
+		return "Unknown Attack Vector";
+	case ParseError::AttackComplexity:
+		return "Unknown Attack Complexity";
+	case ParseError::PrivilegesRequired:
+		return "Unknown Privileges Required";
+	case ParseError::UserInteraction:
+		return "Unknown User Interaction";
+	case ParseError::Scope:
+		return "Unknown Scope";
+	case ParseError::Confidentiality:
+		return "Unknown Confidentiality";
+	case ParseError::Integrity:
+		return "Unknown Integrity";
+	case ParseError::Availability:
+		return "Unknown Availability";
+	case ParseError::ExploitCodeMaturity:
+		return "Unknown Exploit Code Maturity";
+	case ParseError::RemediationLevel:
+		return "Unknown Remediation Level";
+	case ParseError::ReportConfidence:
+		return "Unknown Report Confidence";
+	case ParseError::ConfidentialityRequirement:
+		return "Unknown Confidentiality Requirement";
+	case ParseError::IntegrityRequirement:
+		return "Unknown Integrity Requirement";
+	case ParseError::AvailabilityRequirement:
+		return "Unknown Availability Requirement";
+	case ParseError::ModifiedAttackVector:
+		return "Unknown Modified Attack Vector";
+	case ParseError::ModifiedAttackComplexity:
+		return "Unknown Modified Attack Complexity";
+	case ParseError::ModifiedPrivilegesRequired:
+		return "Unknown Modified Privileges Required";
+	case ParseError::ModifiedUserInteraction:
+		return "Unknown Modified User Interaction";
+	case ParseError::ModifiedScope:
+		return "Unknown Modified Scope";
+	case ParseError::ModifiedConfidentiality:
+		return "Unknown Modified Confidentiality";
+	case ParseError::ModifiedIntegrity:
+		return "Unknown Modified Integrity";
+	case ParseError::ModifiedAvailability:
+		return "Unknown Modified Availability";
+	case ParseError::AttackRequirements:
+		return "Unknown Attack Requirements";
+	case ParseError::VulnerableConfidentiality:
+		return "Unknown Vulnerable System Confidentiality";
+	case ParseError::VulnerableIntegrity:
+		return "Unknown Vulnerable System Integrity";
+	case ParseError::VulnerableAvailability:
+		return "Unknown Vulnerable System Availability";
+	case ParseError::SubsequentConfidentiality:
+		return "Unknown Subsequent System Confidentiality";
+	case ParseError::SubsequentIntegrity:
+		return "Unknown Subsequent System Integrity";
+	case ParseError::SubsequentAvailability:
+		return "Unknown Subsequent System Availability";
+	case ParseError::ModifiedAttackRequirements:
+		return "Unknown Modified Attack Requirements";
+	case ParseError::ModifiedVulnerableConfidentiality:
+		return "Unknown Modified Vulnerable System Confidentiality";
+	case ParseError::ModifiedVulnerableIntegrity:
+		return "Unknown Modified Vulnerable System Integrity";
+	case ParseError::ModifiedVulnerableAvailability:
+		return "Unknown Modified Vulnerable System Availability";
+	case ParseError::ModifiedSubsequentConfidentiality:
+		return "Unknown Modified Subsequent System Confidentiality";
+	case ParseError::ModifiedSubsequentIntegrity:
+		return "Unknown Modified Subsequent System Integrity";
+	case ParseError::ModifiedSubsequentAvailability:
+		return "Unknown Modified Subsequent System Availability";
+	case ParseError::Safety:
+		return "Unknown Safety";
+	case ParseError::Automatable:
+		return "Unknown Automatable";
+	case ParseError::Recovery:
+		return "Unknown Recovery";
+	case ParseError::ValueDensity:
+		return "Unknown Value Density";
+	case ParseError::ResponseEffort:
+		return "Unknown Vulnerability Response Effort";
+	case ParseError::ProviderUrgency:
+		return "Unknown Provider Urgency";
+	case ParseError::Authentication:
+		return "Unknown Authentication";
+	case ParseError::CollateralDamagePotential:
+		return "Unknown Collateral Damage Potential";
+	case ParseError::TargetDistribution:
+		return "Unknown Target Distribution";
+	}
+	return "Unknown error";
+}
+
+void InvalidCVSSLiteral()
+{
+	abort();
+}
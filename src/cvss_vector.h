@@ -0,0 +1,494 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef HAVE_CVSS_VECTOR_H_
+#define HAVE_CVSS_VECTOR_H_
+
+#include "cvss_2.h"
+#include "cvss_3_1.h"
+#include "cvss_4_0.h"
+
+#include <cstddef>
+#include <string_view>
+
+enum class CVSSVersion {
+	V3_0,
+	V3_1,
+	V4_0,
+	V2_0
+};
+
+enum class ParseError {
+	None,
+	UnsupportedVersion,
+	UnknownComponent,
+	AttackVector,
+	AttackComplexity,
+	PrivilegesRequired,
+	UserInteraction,
+	Scope,
+	Confidentiality,
+	Integrity,
+	Availability,
+	ExploitCodeMaturity,
+	RemediationLevel,
+	ReportConfidence,
+	ConfidentialityRequirement,
+	IntegrityRequirement,
+	AvailabilityRequirement,
+	ModifiedAttackVector,
+	ModifiedAttackComplexity,
+	ModifiedPrivilegesRequired,
+	ModifiedUserInteraction,
+	ModifiedScope,
+	ModifiedConfidentiality,
+	ModifiedIntegrity,
+	ModifiedAvailability,
+	AttackRequirements,
+	VulnerableConfidentiality,
+	VulnerableIntegrity,
+	VulnerableAvailability,
+	SubsequentConfidentiality,
+	SubsequentIntegrity,
+	SubsequentAvailability,
+	ModifiedAttackRequirements,
+	ModifiedVulnerableConfidentiality,
+	ModifiedVulnerableIntegrity,
+	ModifiedVulnerableAvailability,
+	ModifiedSubsequentConfidentiality,
+	ModifiedSubsequentIntegrity,
+	ModifiedSubsequentAvailability,
+	Safety,
+	Automatable,
+	Recovery,
+	ValueDensity,
+	ResponseEffort,
+	ProviderUrgency,
+	Authentication,
+	CollateralDamagePotential,
+	TargetDistribution
+};
+
+//plain result of ParseVector(); unspecified metrics keep the same defaults Parse() has always used
+struct ParsedVector
+{
+	CVSSVersion version = CVSSVersion::V3_1;
+
+	AttackVector av = AttackVector::Network;
+	AttackComplexity ac = AttackComplexity::Low;
+	PrivilegesRequired pr = PrivilegesRequired::None;
+	UserInteraction ui = UserInteraction::None;
+	Scope s = Scope::Unchanged;
+	Impact c = Impact::High;
+	Impact i = Impact::High;
+	Impact a = Impact::High;
+
+	ExploitCodeMaturity e = ExploitCodeMaturity::NotDefined;
+	RemediationLevel rl = RemediationLevel::NotDefined;
+	ReportConfidence rc = ReportConfidence::NotDefined;
+
+	Requirement cr = Requirement::NotDefined;
+	Requirement ir = Requirement::NotDefined;
+	Requirement ar = Requirement::NotDefined;
+	Modified<AttackVector> mav = { AttackVector::Network, false };
+	Modified<AttackComplexity> mac = { AttackComplexity::Low, false };
+	Modified<PrivilegesRequired> mpr = { PrivilegesRequired::Low, false };
+	Modified<UserInteraction> mui = { UserInteraction::None, false };
+	Modified<Scope> ms = { Scope::Unchanged, false };
+	Modified<Impact> mc = { Impact::High, false };
+	Modified<Impact> mi = { Impact::High, false };
+	Modified<Impact> ma = { Impact::High, false };
+
+	ParseError error = ParseError::None;
+	size_t errorOffset = 0; //start of the offending value (or component) in the input
+	size_t errorLength = 0; //length of the offending value (or component)
+};
+
+//plain result of ParseVector4()
+struct ParsedVector4 : Vector4Metrics
+{
+	ParseError error = ParseError::None;
+	size_t errorOffset = 0; //see ParsedVector::errorOffset
+	size_t errorLength = 0; //see ParsedVector::errorLength
+};
+
+//plain result of ParseVector2()
+struct ParsedVector2 : Vector2Metrics
+{
+	ParseError error = ParseError::None;
+	size_t errorOffset = 0; //see ParsedVector::errorOffset
+	size_t errorLength = 0; //see ParsedVector::errorLength
+};
+
+//the CVSS 2.0, 3.x and 4.0 vector grammars; everything is constexpr so literals can be parsed at compile time (see operator""_cvss)
+class VectorParser
+{
+	private:
+		//one metric: its key, its values in the order of its enum (letters, or comma-separated words), the error for any other value, and
+		//the field it sets; modified metrics list "X" first, which clears them
+		template<typename Vector> struct MetricGrammar
+		{
+			std::string_view key;
+			std::string_view values;
+			ParseError error;
+			void (*assign)(Vector &v, size_t value);
+		};
+
+		template<typename T, auto Field, typename Vector> static constexpr void Assign(Vector &v, size_t value)
+		{
+			v.*Field = static_cast<T>(value);
+		}
+
+		//X puts the metric back to its default, so "MAV:N/MAV:X" leaves nothing of the N behind
+		template<typename T, auto Field, typename Vector> static constexpr void AssignModified(Vector &v, size_t value)
+		{
+			(v.*Field).modified = (value != 0);
+			(v.*Field).parent = (value != 0) ? static_cast<T>(value - 1) : (Vector().*Field).parent;
+		}
+
+		static constexpr MetricGrammar<ParsedVector> Grammar[] = {
+			{ "AV", "NALP", ParseError::AttackVector, Assign<AttackVector, &ParsedVector::av> }, // Attack Vector (AV)
+			{ "AC", "LH", ParseError::AttackComplexity, Assign<AttackComplexity, &ParsedVector::ac> }, // Attack Complexity (AC)
+			{ "PR", "NLH", ParseError::PrivilegesRequired, Assign<PrivilegesRequired, &ParsedVector::pr> }, // Privileges Required (PR)
+			{ "UI", "NR", ParseError::UserInteraction, Assign<UserInteraction, &ParsedVector::ui> }, // User Interaction (UI)
+			{ "S", "UC", ParseError::Scope, Assign<Scope, &ParsedVector::s> }, // Scope (S)
+			{ "C", "HLN", ParseError::Confidentiality, Assign<Impact, &ParsedVector::c> }, // Confidentiality (C)
+			{ "I", "HLN", ParseError::Integrity, Assign<Impact, &ParsedVector::i> }, // Integrity (I)
+			{ "A", "HLN", ParseError::Availability, Assign<Impact, &ParsedVector::a> }, // Availability (A)
+			{ "E", "XHFPU", ParseError::ExploitCodeMaturity, Assign<ExploitCodeMaturity, &ParsedVector::e> }, // Exploit Code Maturity (E)
+			{ "RL", "XUWTO", ParseError::RemediationLevel, Assign<RemediationLevel, &ParsedVector::rl> }, // Remediation Level (RL)
+			{ "RC", "XCRU", ParseError::ReportConfidence, Assign<ReportConfidence, &ParsedVector::rc> }, // Report Confidence (RC)
+			{ "CR", "XHML", ParseError::ConfidentialityRequirement, Assign<Requirement, &ParsedVector::cr> }, // Confidentiality Requirement (CR)
+			{ "IR", "XHML", ParseError::IntegrityRequirement, Assign<Requirement, &ParsedVector::ir> }, // Integrity Requirement (IR)
+			{ "AR", "XHML", ParseError::AvailabilityRequirement, Assign<Requirement, &ParsedVector::ar> }, // Availability Requirement (AR)
+			{ "MAV", "XNALP", ParseError::ModifiedAttackVector, AssignModified<AttackVector, &ParsedVector::mav> }, // Modified Attack Vector (MAV)
+			{ "MAC", "XLH", ParseError::ModifiedAttackComplexity, AssignModified<AttackComplexity, &ParsedVector::mac> }, // Modified Attack Complexity (MAC)
+			{ "MPR", "XNLH", ParseError::ModifiedPrivilegesRequired, AssignModified<PrivilegesRequired, &ParsedVector::mpr> }, // Modified Privileges Required (MPR)
+			{ "MUI", "XNR", ParseError::ModifiedUserInteraction, AssignModified<UserInteraction, &ParsedVector::mui> }, // Modified User Interaction (MUI)
+			{ "MS", "XUC", ParseError::ModifiedScope, AssignModified<Scope, &ParsedVector::ms> }, // Modified Scope (MS)
+			{ "MC", "XHLN", ParseError::ModifiedConfidentiality, AssignModified<Impact, &ParsedVector::mc> }, // Modified Confidentiality (MC)
+			{ "MI", "XHLN", ParseError::ModifiedIntegrity, AssignModified<Impact, &ParsedVector::mi> }, // Modified Integrity (MI)
+			{ "MA", "XHLN", ParseError::ModifiedAvailability, AssignModified<Impact, &ParsedVector::ma> } // Modified Availability (MA)
+		};
+
+		//4.0 keeps the 3.x errors for the metrics it shares; the Provider Urgency (U) values are words, see ParseComponent()
+		static constexpr MetricGrammar<ParsedVector4> Grammar4[] = {
+			{ "AV", "NALP", ParseError::AttackVector, Assign<AttackVector, &ParsedVector4::av> }, // Attack Vector (AV)
+			{ "AC", "LH", ParseError::AttackComplexity, Assign<AttackComplexity, &ParsedVector4::ac> }, // Attack Complexity (AC)
+			{ "AT", "NP", ParseError::AttackRequirements, Assign<AttackRequirements, &ParsedVector4::at> }, // Attack Requirements (AT)
+			{ "PR", "NLH", ParseError::PrivilegesRequired, Assign<PrivilegesRequired, &ParsedVector4::pr> }, // Privileges Required (PR)
+			{ "UI", "NPA", ParseError::UserInteraction, Assign<UserInteraction4, &ParsedVector4::ui> }, // User Interaction (UI)
+			{ "VC", "HLN", ParseError::VulnerableConfidentiality, Assign<Impact, &ParsedVector4::vc> }, // Vulnerable System Confidentiality (VC)
+			{ "VI", "HLN", ParseError::VulnerableIntegrity, Assign<Impact, &ParsedVector4::vi> }, // Vulnerable System Integrity (VI)
+			{ "VA", "HLN", ParseError::VulnerableAvailability, Assign<Impact, &ParsedVector4::va> }, // Vulnerable System Availability (VA)
+			{ "SC", "HLN", ParseError::SubsequentConfidentiality, Assign<SystemImpact, &ParsedVector4::sc> }, // Subsequent System Confidentiality (SC)
+			{ "SI", "HLN", ParseError::SubsequentIntegrity, Assign<SystemImpact, &ParsedVector4::si> }, // Subsequent System Integrity (SI)
+			{ "SA", "HLN", ParseError::SubsequentAvailability, Assign<SystemImpact, &ParsedVector4::sa> }, // Subsequent System Availability (SA)
+			{ "E", "XAPU", ParseError::ExploitCodeMaturity, Assign<ExploitMaturity, &ParsedVector4::e> }, // Exploit Maturity (E)
+			{ "CR", "XHML", ParseError::ConfidentialityRequirement, Assign<Requirement, &ParsedVector4::cr> }, // Confidentiality Requirement (CR)
+			{ "IR", "XHML", ParseError::IntegrityRequirement, Assign<Requirement, &ParsedVector4::ir> }, // Integrity Requirement (IR)
+			{ "AR", "XHML", ParseError::AvailabilityRequirement, Assign<Requirement, &ParsedVector4::ar> }, // Availability Requirement (AR)
+			{ "MAV", "XNALP", ParseError::ModifiedAttackVector, AssignModified<AttackVector, &ParsedVector4::mav> }, // Modified Attack Vector (MAV)
+			{ "MAC", "XLH", ParseError::ModifiedAttackComplexity, AssignModified<AttackComplexity, &ParsedVector4::mac> }, // Modified Attack Complexity (MAC)
+			{ "MAT", "XNP", ParseError::ModifiedAttackRequirements, AssignModified<AttackRequirements, &ParsedVector4::mat> }, // Modified Attack Requirements (MAT)
+			{ "MPR", "XNLH", ParseError::ModifiedPrivilegesRequired, AssignModified<PrivilegesRequired, &ParsedVector4::mpr> }, // Modified Privileges Required (MPR)
+			{ "MUI", "XNPA", ParseError::ModifiedUserInteraction, AssignModified<UserInteraction4, &ParsedVector4::mui> }, // Modified User Interaction (MUI)
+			{ "MVC", "XHLN", ParseError::ModifiedVulnerableConfidentiality, AssignModified<Impact, &ParsedVector4::mvc> }, // Modified Vulnerable System Confidentiality (MVC)
+			{ "MVI", "XHLN", ParseError::ModifiedVulnerableIntegrity, AssignModified<Impact, &ParsedVector4::mvi> }, // Modified Vulnerable System Integrity (MVI)
+			{ "MVA", "XHLN", ParseError::ModifiedVulnerableAvailability, AssignModified<Impact, &ParsedVector4::mva> }, // Modified Vulnerable System Availability (MVA)
+			{ "MSC", "XHLN", ParseError::ModifiedSubsequentConfidentiality, AssignModified<SystemImpact, &ParsedVector4::msc> }, // Modified Subsequent System Confidentiality (MSC)
+			{ "MSI", "XHLNS", ParseError::ModifiedSubsequentIntegrity, AssignModified<SystemImpact, &ParsedVector4::msi> }, // Modified Subsequent System Integrity (MSI)
+			{ "MSA", "XHLNS", ParseError::ModifiedSubsequentAvailability, AssignModified<SystemImpact, &ParsedVector4::msa> }, // Modified Subsequent System Availability (MSA)
+			{ "S", "XNP", ParseError::Safety, Assign<Safety, &ParsedVector4::s> }, // Safety (S)
+			{ "AU", "XNY", ParseError::Automatable, Assign<Automatable, &ParsedVector4::au> }, // Automatable (AU)
+			{ "R", "XAUI", ParseError::Recovery, Assign<Recovery, &ParsedVector4::r> }, // Recovery (R)
+			{ "V", "XDC", ParseError::ValueDensity, Assign<ValueDensity, &ParsedVector4::v> }, // Value Density (V)
+			{ "RE", "XLMH", ParseError::ResponseEffort, Assign<ResponseEffort, &ParsedVector4::re> } // Vulnerability Response Effort (RE)
+		};
+
+		//2.0 keeps the 3.x errors for the metrics it shares; "Au" is also accepted as "AU" because the command
+		//line upper-cases its vector, and the temporal and environmental values are words
+		static constexpr MetricGrammar<ParsedVector2> Grammar2[] = {
+			{ "AV", "LAN", ParseError::AttackVector, Assign<AccessVector, &ParsedVector2::av> }, // Access Vector (AV)
+			{ "AC", "HML", ParseError::AttackComplexity, Assign<AccessComplexity, &ParsedVector2::ac> }, // Access Complexity (AC)
+			{ "Au", "MSN", ParseError::Authentication, Assign<Authentication, &ParsedVector2::au> }, // Authentication (Au)
+			{ "AU", "MSN", ParseError::Authentication, Assign<Authentication, &ParsedVector2::au> }, // Authentication (Au)
+			{ "C", "NPC", ParseError::Confidentiality, Assign<Impact2, &ParsedVector2::c> }, // Confidentiality Impact (C)
+			{ "I", "NPC", ParseError::Integrity, Assign<Impact2, &ParsedVector2::i> }, // Integrity Impact (I)
+			{ "A", "NPC", ParseError::Availability, Assign<Impact2, &ParsedVector2::a> }, // Availability Impact (A)
+			{ "E", "ND,U,POC,F,H", ParseError::ExploitCodeMaturity, Assign<Exploitability, &ParsedVector2::e> }, // Exploitability (E)
+			{ "RL", "ND,OF,TF,W,U", ParseError::RemediationLevel, Assign<RemediationLevel2, &ParsedVector2::rl> }, // Remediation Level (RL)
+			{ "RC", "ND,UC,UR,C", ParseError::ReportConfidence, Assign<ReportConfidence2, &ParsedVector2::rc> }, // Report Confidence (RC)
+			{ "CDP", "ND,N,L,LM,MH,H", ParseError::CollateralDamagePotential, Assign<CollateralDamagePotential, &ParsedVector2::cdp> }, // Collateral Damage Potential (CDP)
+			{ "TD", "ND,N,L,M,H", ParseError::TargetDistribution, Assign<TargetDistribution, &ParsedVector2::td> }, // Target Distribution (TD)
+			{ "CR", "ND,H,M,L", ParseError::ConfidentialityRequirement, Assign<Requirement, &ParsedVector2::cr> }, // Confidentiality Requirement (CR)
+			{ "IR", "ND,H,M,L", ParseError::IntegrityRequirement, Assign<Requirement, &ParsedVector2::ir> }, // Integrity Requirement (IR)
+			{ "AR", "ND,H,M,L", ParseError::AvailabilityRequirement, Assign<Requirement, &ParsedVector2::ar> } // Availability Requirement (AR)
+		};
+
+		static constexpr std::string_view ProviderUrgencyValues[] = { "X", "Clear", "Green", "Amber", "Red" };
+
+		static constexpr bool EqualsIgnoringCase(std::string_view a, std::string_view b)
+		{
+			if (a.length() != b.length())
+				return false;
+			for (size_t n = 0; n < a.length(); n++)
+			{
+				char ca = ((a[n] >= 'a') && (a[n] <= 'z')) ? static_cast<char>(a[n] - 'a' + 'A') : a[n];
+				char cb = ((b[n] >= 'a') && (b[n] <= 'z')) ? static_cast<char>(b[n] - 'a' + 'A') : b[n];
+				if (ca != cb)
+					return false;
+			}
+			return true;
+		}
+
+		//perfect hash of the one- to three-letter metric keys into KeySlots slots; the static_asserts in
+		//ParseComponent() fail the build if a new key collides, and the multipliers then need changing
+		static constexpr size_t KeySlots = 128;
+		static constexpr size_t NoMetric = 0xFF;
+		static constexpr size_t HashKey(std::string_view key)
+		{
+			size_t ret = 0;
+			const size_t multipliers[3] = { 2, 7, 12 };
+			for (size_t n = 0; (n < key.length()) && (n < 3); n++)
+				ret += static_cast<unsigned char>(key[n]) * multipliers[n];
+			return ret & (KeySlots - 1);
+		}
+
+		struct KeyTable
+		{
+			unsigned char slots[KeySlots] = {};
+		};
+
+		template<typename Vector, size_t Count> static constexpr KeyTable BuildKeyTable(MetricGrammar<Vector> const (&grammar)[Count])
+		{
+			KeyTable ret;
+			for (size_t slot = 0; slot < KeySlots; slot++)
+				ret.slots[slot] = NoMetric;
+			for (size_t metric = 0; metric < Count; metric++)
+			{
+				size_t slot = HashKey(grammar[metric].key);
+				ret.slots[slot] = (ret.slots[slot] == NoMetric) ? static_cast<unsigned char>(metric) : NoMetric - 1;
+			}
+			return ret;
+		}
+
+		template<typename Vector, size_t Count> static constexpr bool KeysArePerfect(MetricGrammar<Vector> const (&grammar)[Count])
+		{
+			KeyTable table = BuildKeyTable(grammar);
+			for (size_t metric = 0; metric < Count; metric++)
+			{
+				if (table.slots[HashKey(grammar[metric].key)] != metric)
+					return false;
+			}
+			return true;
+		}
+
+		static constexpr ParseError ParseVersion(ParsedVector &ret, std::string_view value)
+		{
+			if (value == "3.1")
+			{
+				ret.version = CVSSVersion::V3_1;
+				return ParseError::None;
+			}
+			if (value == "3.0")
+			{
+				ret.version = CVSSVersion::V3_0;
+				return ParseError::None;
+			}
+			return ParseError::UnsupportedVersion;
+		}
+
+		static constexpr ParseError ParseVersion(ParsedVector4 &, std::string_view value)
+		{
+			return (value == "4.0") ? ParseError::None : ParseError::UnsupportedVersion;
+		}
+
+		static constexpr ParseError ParseVersion(ParsedVector2 &, std::string_view)
+		{
+			return ParseError::UnsupportedVersion; //2.0 vectors carry no version
+		}
+
+		static constexpr ParseError ParseMetric(ParsedVector2 &ret, std::string_view key, std::string_view value)
+		{
+			static_assert(KeysArePerfect(Grammar2), "2.0 metric keys collide in HashKey()");
+			constexpr KeyTable keys = BuildKeyTable(Grammar2);
+			return ParseMetric(Grammar2, keys, ret, key, value);
+		}
+
+		static constexpr ParseError ParseMetric(ParsedVector &ret, std::string_view key, std::string_view value)
+		{
+			static_assert(KeysArePerfect(Grammar), "metric keys collide in HashKey()");
+			constexpr KeyTable keys = BuildKeyTable(Grammar);
+			return ParseMetric(Grammar, keys, ret, key, value);
+		}
+
+		static constexpr ParseError ParseMetric(ParsedVector4 &ret, std::string_view key, std::string_view value)
+		{
+			if (key == "U") // Provider Urgency (U); the command line upper-cases its vector, so any case matches
+			{
+				for (size_t n = 0; n < sizeof(ProviderUrgencyValues) / sizeof(ProviderUrgencyValues[0]); n++)
+				{
+					if (EqualsIgnoringCase(value, ProviderUrgencyValues[n]))
+					{
+						ret.u = static_cast<ProviderUrgency>(n);
+						return ParseError::None;
+					}
+				}
+				return ParseError::ProviderUrgency;
+			}
+
+			static_assert(KeysArePerfect(Grammar4), "4.0 metric keys collide in HashKey()");
+			constexpr KeyTable keys = BuildKeyTable(Grammar4);
+			return ParseMetric(Grammar4, keys, ret, key, value);
+		}
+
+		//index of value in a metric's values, or npos
+		static constexpr size_t FindValue(std::string_view values, std::string_view value)
+		{
+			if (values.find(',') == std::string_view::npos) //single letters
+				return (value.length() == 1) ? values.find(value[0]) : std::string_view::npos;
+
+			size_t index = 0;
+			size_t start = 0;
+			while (true)
+			{
+				size_t end = values.find(',', start);
+				if (values.substr(start, (end == std::string_view::npos) ? std::string_view::npos : end - start) == value)
+					return index;
+				if (end == std::string_view::npos)
+					return std::string_view::npos;
+				index++;
+				start = end + 1;
+			}
+		}
+
+		template<typename Vector, size_t Count> static constexpr ParseError ParseMetric(MetricGrammar<Vector> const (&grammar)[Count], KeyTable const& keys, Vector &ret, std::string_view key, std::string_view value)
+		{
+			size_t metric = keys.slots[HashKey(key)];
+			if ((metric >= Count) || (grammar[metric].key != key))
+				return ParseError::UnknownComponent;
+
+			size_t index = FindValue(grammar[metric].values, value);
+			if (index == std::string_view::npos)
+				return grammar[metric].error;
+			grammar[metric].assign(ret, index);
+			return ParseError::None;
+		}
+
+		template<typename Vector> static constexpr ParseError ParseComponent(Vector &ret, std::string_view key, std::string_view value)
+		{
+			if (key == "CVSS") // CVSS Version
+				return ParseVersion(ret, value);
+			return ParseMetric(ret, key, value);
+		}
+
+	public:
+		template<typename Vector> static constexpr Vector Parse(std::string_view data)
+		{
+			Vector ret;
+			size_t start = 0;
+			while (true)
+			{
+				size_t end = data.find('/', start);
+				std::string_view component = data.substr(start, (end == std::string_view::npos) ? std::string_view::npos : end - start);
+				size_t colon = component.find(':');
+				ParseError error = (colon == std::string_view::npos) ? ParseError::UnknownComponent : ParseComponent(ret, component.substr(0, colon), component.substr(colon + 1));
+				if (error != ParseError::None)
+				{
+					ret.error = error;
+					if (error == ParseError::UnknownComponent)
+					{
+						ret.errorOffset = start;
+						ret.errorLength = component.length();
+					}
+					else
+					{
+						ret.errorOffset = start + colon + 1;
+						ret.errorLength = component.length() - colon - 1;
+					}
+					return ret;
+				}
+				if (end == std::string_view::npos)
+					break;
+				start = end + 1;
+			}
+			return ret;
+		}
+};
+
+constexpr ParsedVector ParseVector(std::string_view data) //never allocates; check error before using the metrics
+{
+	return VectorParser::Parse<ParsedVector>(data);
+}
+
+//whether the vector is 4.0, which has its own grammar; 4.0 vectors must start with their version
+constexpr bool IsVector4(std::string_view data)
+{
+	return (data.substr(0, 8) == "CVSS:4.0") && ((data.length() == 8) || (data[8] == '/'));
+}
+
+//whether the vector is 2.0; 2.0 vectors have no version, so they are told apart by their leading
+//AV, AC and Au metrics, which are in that order in every 2.0 vector and never in a 3.x one
+constexpr bool IsVector2(std::string_view data)
+{
+	return (data.length() >= 13) && (data.substr(0, 3) == "AV:") && (data.substr(4, 4) == "/AC:") && (data[9] == '/') && ((data.substr(10, 3) == "Au:") || (data.substr(10, 3) == "AU:"));
+}
+
+enum class VectorGrammar {
+	V2,
+	V3,
+	V4
+};
+
+//which grammar parses the vector, from its first few bytes; 3.x is the default
+constexpr VectorGrammar GetVectorGrammar(std::string_view data)
+{
+	if (IsVector4(data))
+		return VectorGrammar::V4;
+	if (IsVector2(data))
+		return VectorGrammar::V2;
+	return VectorGrammar::V3;
+}
+
+constexpr ParsedVector2 ParseVector2(std::string_view data) //same as ParseVector(), for the 2.0 grammar
+{
+	return VectorParser::Parse<ParsedVector2>(data);
+}
+
+constexpr ParsedVector4 ParseVector4(std::string_view data) //same as ParseVector(), for the 4.0 grammar
+{
+	return VectorParser::Parse<ParsedVector4>(data);
+}
+
+const char *ParseErrorString(ParseError error); //e.g. "Unknown Attack Vector"
+
+void InvalidCVSSLiteral(); //aborts; a _cvss literal that fails to parse reaches it, which is not a constant expression
+
+//"CVSS:3.1/AV:N/..."_cvss parses at compile time when used in a constant expression; a malformed literal
+//then fails the build
+constexpr ParsedVector operator""_cvss(const char *data, size_t length)
+{
+	ParsedVector ret = ParseVector(std::string_view(data, length));
+	if (ret.error != ParseError::None)
+		InvalidCVSSLiteral();
+	return ret;
+}
+
+#endif
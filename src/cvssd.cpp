@@ -0,0 +1,304 @@
+/*
+CVSS
+Copyright (C) 2023 Jon Hood <jwh0011@auburn.edu>
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software Foundation,
+Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+#include "cvss_cache.h"
+#include "cvss_profile.h"
+#include "cvss_server.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+//per-connection buffers, sized once when the connection is accepted
+const size_t InputSize = 64 * 1024; //holds many pipelined requests, and always a whole one
+const size_t OutputLimit = 64 * 1024; //answering pauses here until the client reads
+const size_t ReadsPerWakeup = 16; //so one busy client cannot starve the others
+
+struct Connection
+{
+	int fd;
+	ScoreSession session;
+	vector<char> input;
+	size_t inputSize = 0;
+	uint64_t receivedAt = 0;
+	string output;
+	size_t written = 0;
+	uint32_t events = 0; //what epoll is watching for
+	bool closed = false; //the client has finished sending
+
+	Connection(int descriptor, ScoreSession const& scoreSession) : fd(descriptor), session(scoreSession), input(InputSize)
+	{
+		output.reserve(OutputLimit + 2 * MaxRequestSize);
+	}
+};
+
+static bool Watch(int epoll, Connection &connection, uint32_t events)
+{
+	if (connection.events == events)
+		return true;
+	epoll_event event = {};
+	event.events = events;
+	event.data.ptr = &connection;
+	connection.events = events;
+	return epoll_ctl(epoll, EPOLL_CTL_MOD, connection.fd, &event) == 0;
+}
+
+//answers, writes and reads until the socket would block; false once the connection should be closed
+static bool Service(int epoll, Connection &connection)
+{
+	size_t reads = 0;
+	while (true)
+	{
+		size_t consumed = connection.session.Process(string_view(connection.input.data(), connection.inputSize), connection.output, OutputLimit, connection.receivedAt);
+		if (consumed == string_view::npos)
+			return false; //a request longer than MaxRequestSize
+		if (consumed)
+		{
+			memmove(connection.input.data(), connection.input.data() + consumed, connection.inputSize - consumed);
+			connection.inputSize -= consumed;
+		}
+
+		while (connection.written < connection.output.size())
+		{
+			ssize_t n = write(connection.fd, connection.output.data() + connection.written, connection.output.size() - connection.written);
+			if (n > 0)
+				connection.written += static_cast<size_t>(n);
+			else if ((n < 0) && (errno == EINTR))
+				continue;
+			else if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+				return Watch(epoll, connection, EPOLLOUT); //stop reading until the client catches up
+			else
+				return false;
+		}
+		connection.output.clear();
+		connection.written = 0;
+		if (consumed)
+			continue; //answering may have stopped at OutputLimit
+		if (connection.closed)
+			return false;
+		if (reads == ReadsPerWakeup)
+			return Watch(epoll, connection, EPOLLIN); //epoll reports the rest of the input again
+
+		ssize_t n = read(connection.fd, connection.input.data() + connection.inputSize, InputSize - connection.inputSize);
+		if (n > 0)
+		{
+			connection.inputSize += static_cast<size_t>(n);
+			connection.receivedAt = GetSteadyNanoseconds();
+			reads++;
+		}
+		else if (n == 0)
+		{
+			connection.closed = true; //answer what is left, then close
+		}
+		else if (errno == EINTR)
+		{
+			continue;
+		}
+		else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+		{
+			return Watch(epoll, connection, EPOLLIN);
+		}
+		else
+		{
+			return false;
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bool baseScore = false;
+	bool temporalScore = false;
+	bool environmentalScore = false;
+	string socketPath = "/tmp/cvssd.sock";
+	size_t cacheSize = 0;
+	EnvironmentalProfile profile;
+	EnvironmentalProfile const *envProfile = nullptr;
+
+	for (int i2 = 1; i2 < argc; i2++)
+	{
+		string arg(argv[i2]);
+		transform(arg.begin(), arg.end(), arg.begin(), ::toupper);
+
+		if ((arg.rfind("-H", 0) == 0) || (arg.rfind("--HELP", 0) == 0))
+		{
+			cout << "Usage: ./cvssd [--socket path]" << endl;
+			cout << endl;
+			cout << "Answers CVSS vectors sent over a Unix socket, one per line or as 4-byte big-endian length-prefixed frames." << endl;
+			cout << "The request STATS returns request, error and connection counts and p50/p99 latency." << endl;
+			cout << endl;
+			cout << " -a  Answer with base, temporal, and environmental score." << endl;
+			cout << " -b  Answer with base score." << endl;
+			cout << " -t  Answer with temporal score." << endl;
+			cout << " -e  Answer with environmental score." << endl;
+			cout << " --socket path  Listen on path (default /tmp/cvssd.sock)." << endl;
+			cout << " --cache N  Remember the scores of up to N distinct vectors." << endl;
+			cout << " --env-profile \"CR:H/IR:H/MAV:L\"  Overlay environmental metrics on every vector." << endl;
+			return EXIT_SUCCESS;
+		}
+		else if (arg.compare("--SOCKET") == 0)
+		{
+			if (i2 + 1 < argc)
+				socketPath = argv[++i2];
+		}
+		else if (arg.compare("--CACHE") == 0)
+		{
+			if (i2 + 1 < argc)
+				cacheSize = static_cast<size_t>(strtoull(argv[++i2], nullptr, 10));
+		}
+		else if (arg.compare("--ENV-PROFILE") == 0)
+		{
+			if (i2 + 1 < argc)
+			{
+				string_view text(argv[++i2]);
+				size_t offset = 0, length = 0;
+				ParseError error = profile.Parse(text, &offset, &length);
+				if (error != ParseError::None)
+				{
+					cerr << "Invalid environmental profile: " << ParseErrorString(error) << ": " << text.substr(offset, length) << endl;
+					return EXIT_FAILURE;
+				}
+				envProfile = &profile;
+			}
+		}
+		else if ((arg.rfind("-A", 0) == 0))
+		{
+			baseScore = true;
+			temporalScore = true;
+			environmentalScore = true;
+		}
+		else if ((arg.rfind("-B", 0) == 0))
+		{
+			baseScore = true;
+		}
+		else if ((arg.rfind("-T", 0) == 0))
+		{
+			temporalScore = true;
+		}
+		else if ((arg.rfind("-E", 0) == 0))
+		{
+			environmentalScore = true;
+		}
+		else
+		{
+			cerr << "Unknown option " << argv[i2] << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		cerr << "Socket path too long: " << socketPath << endl;
+		return EXIT_FAILURE;
+	}
+	memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+	//SIGUSR1 prints the counters; SIGINT and SIGTERM print them and stop. All arrive through epoll
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	sigaddset(&signals, SIGUSR1);
+	sigprocmask(SIG_BLOCK, &signals, nullptr);
+	signal(SIGPIPE, SIG_IGN);
+	int signalDescriptor = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	unlink(socketPath.c_str());
+	if ((listener < 0) || (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) || (listen(listener, SOMAXCONN) != 0))
+	{
+		cerr << "Unable to listen on " << socketPath << ": " << strerror(errno) << endl;
+		return EXIT_FAILURE;
+	}
+
+	int epoll = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event event = {};
+	event.events = EPOLLIN;
+	event.data.ptr = &listener;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &event);
+	event.data.ptr = &signalDescriptor;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, signalDescriptor, &event);
+
+	unique_ptr<ScoreCache> cache(cacheSize ? new ScoreCache(cacheSize, 1, envProfile) : nullptr);
+	ServerStats stats;
+	ScoreSession session(baseScore, temporalScore, environmentalScore, cache.get(), envProfile, &stats);
+	vector<epoll_event> events(64);
+	bool running = true;
+	while (running)
+	{
+		int ready = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), -1);
+		if ((ready < 0) && (errno != EINTR))
+			break;
+		for (int n = 0; n < ready; n++)
+		{
+			if (events[n].data.ptr == &listener)
+			{
+				int fd;
+				while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+				{
+					Connection *connection = new Connection(fd, session);
+					connection->events = EPOLLIN;
+					epoll_event added = {};
+					added.events = EPOLLIN;
+					added.data.ptr = connection;
+					epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &added);
+					stats.connections++;
+				}
+			}
+			else if (events[n].data.ptr == &signalDescriptor)
+			{
+				signalfd_siginfo info;
+				while (read(signalDescriptor, &info, sizeof(info)) == sizeof(info))
+				{
+					cerr << stats.Format() << endl;
+					if (info.ssi_signo != SIGUSR1)
+						running = false;
+				}
+			}
+			else
+			{
+				Connection *connection = static_cast<Connection*>(events[n].data.ptr);
+				if (!Service(epoll, *connection))
+				{
+					epoll_ctl(epoll, EPOLL_CTL_DEL, connection->fd, nullptr);
+					close(connection->fd);
+					delete connection;
+				}
+			}
+		}
+	}
+
+	close(listener);
+	unlink(socketPath.c_str());
+	return EXIT_SUCCESS;
+}
@@ -20,18 +20,57 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "cvss.h"
 #include "cvss_3.h"
 #include "cvss_3_1.h"
+#include "cvss_mmap.h"
+#include "cvss_profile.h"
+#include "cvss_stats.h"
 #include <algorithm>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 using namespace std;
 
+//hands score the named input: standard input for "-", a memory map of a regular file, or else a stream (e.g. a named pipe)
+template<typename Score> static int ScoreInput(string const& path, Score score)
+{
+	ios::sync_with_stdio(false);
+	if (path.compare("-") == 0)
+		return score(cin);
+	MappedFile mapped;
+	if (mapped.Open(path))
+		return score(mapped.GetData());
+	ifstream in(path, ios::binary);
+	if (!in)
+	{
+		cerr << "Unable to open " << path << endl;
+		return EXIT_FAILURE;
+	}
+	return score(in);
+}
+
 int main(int argc, char *argv[])
 {
 	bool baseScore = false;
 	bool temporalScore = false;
 	bool environmentalScore = false;
+	bool batch = false;
+	string batchFile = "-";
+	unsigned threads = 1;
+	size_t cacheSize = 0;
+	EnvironmentalProfile profile;
+	EnvironmentalProfile const *envProfile = nullptr;
+	bool binary = false;
+	bool stats = false;
+	bool summary = false;
+	bool distinct = false;
+	string indexFile;
+	bool nvd = false;
+	char csvDelimiter = '\0';
+	size_t csvColumn = 1;
+	bool csvHeader = false;
+	bool batchOnly = false; //--threads, --binary, --summary, --distinct or --index was given
 
 	string tmpCvssVersion = "3.1";
 
@@ -48,6 +87,103 @@ int main(int argc, char *argv[])
 			cout << " -b  Display base score." << endl;
 			cout << " -t  Display temporal score." << endl;
 			cout << " -e  Display environmental score." << endl;
+			cout << " --batch [file|-]  Score one vector per line from a file or standard input." << endl;
+			cout << " --nvd [file|-]  Score the CVSS vectors of an NVD CVE JSON feed, keyed by CVE ID." << endl;
+			cout << " --csv [file|-]  Copy CSV rows through with score and severity columns appended." << endl;
+			cout << " --tsv [file|-]  Copy tab-separated rows through with score and severity columns appended." << endl;
+			cout << " --column N  With --csv or --tsv, score the vector in column N (from 1; the default is 1)." << endl;
+			cout << " --header  With --csv or --tsv, the first row names the columns." << endl;
+			cout << " --threads N  Score batches on N threads (0 uses every hardware thread)." << endl;
+			cout << " --cache N  Remember the scores of at most N distinct vectors in batch mode." << endl;
+			cout << " --env-profile \"CR:H/IR:H/MAV:L\"  Overlay environmental metrics on every vector." << endl;
+			cout << " --binary  Write batch scores as binary column blocks instead of text." << endl;
+			cout << " --summary  Print counts, means, percentiles, severity bands and base metric values of a batch instead of its scores." << endl;
+			cout << " --distinct  Print each distinct vector of a batch once, with its count, instead of its scores." << endl;
+			cout << " --index file  With --distinct, write the output line of each input line's vector to file." << endl;
+			cout << " --stats  Print per-stage timings and parse counters to standard error after a batch." << endl;
+		}
+		else if (arg.compare("--BATCH") == 0)
+		{
+			batch = true;
+			if ((i2 + 1 < argc) && ((argv[i2 + 1][0] != '-') || (string(argv[i2 + 1]).compare("-") == 0)))
+				batchFile = argv[++i2];
+		}
+		else if (arg.compare("--NVD") == 0)
+		{
+			nvd = true;
+			if ((i2 + 1 < argc) && ((argv[i2 + 1][0] != '-') || (string(argv[i2 + 1]).compare("-") == 0)))
+				batchFile = argv[++i2];
+		}
+		else if ((arg.compare("--CSV") == 0) || (arg.compare("--TSV") == 0))
+		{
+			csvDelimiter = (arg.compare("--CSV") == 0) ? ',' : '\t';
+			if ((i2 + 1 < argc) && ((argv[i2 + 1][0] != '-') || (string(argv[i2 + 1]).compare("-") == 0)))
+				batchFile = argv[++i2];
+		}
+		else if (arg.compare("--COLUMN") == 0)
+		{
+			if (i2 + 1 < argc)
+				csvColumn = static_cast<size_t>(strtoull(argv[++i2], nullptr, 10));
+			if (csvColumn == 0)
+			{
+				cerr << "Columns are numbered from 1" << endl;
+				return EXIT_FAILURE;
+			}
+		}
+		else if (arg.compare("--HEADER") == 0)
+		{
+			csvHeader = true;
+		}
+		else if (arg.compare("--THREADS") == 0)
+		{
+			batchOnly = true;
+			if (i2 + 1 < argc)
+				threads = static_cast<unsigned>(strtoul(argv[++i2], nullptr, 10));
+		}
+		else if (arg.compare("--CACHE") == 0)
+		{
+			if (i2 + 1 < argc)
+				cacheSize = static_cast<size_t>(strtoull(argv[++i2], nullptr, 10));
+		}
+		else if (arg.compare("--ENV-PROFILE") == 0)
+		{
+			if (i2 + 1 < argc)
+			{
+				string_view text(argv[++i2]);
+				size_t offset = 0, length = 0;
+				ParseError error = profile.Parse(text, &offset, &length);
+				if (error != ParseError::None)
+				{
+					cerr << "Invalid environmental profile: " << ParseErrorString(error) << ": " << text.substr(offset, length) << endl;
+					return EXIT_FAILURE;
+				}
+				envProfile = &profile;
+			}
+		}
+		else if (arg.compare("--BINARY") == 0)
+		{
+			binary = true;
+			batchOnly = true;
+		}
+		else if (arg.compare("--SUMMARY") == 0)
+		{
+			summary = true;
+			batchOnly = true;
+		}
+		else if (arg.compare("--DISTINCT") == 0)
+		{
+			distinct = true;
+			batchOnly = true;
+		}
+		else if (arg.compare("--INDEX") == 0)
+		{
+			batchOnly = true;
+			if (i2 + 1 < argc)
+				indexFile = argv[++i2];
+		}
+		else if (arg.compare("--STATS") == 0)
+		{
+			stats = true;
 		}
 		else if ((arg.rfind("-A", 0) == 0))
 		{
@@ -69,8 +205,63 @@ int main(int argc, char *argv[])
 		}
 		else
 		{
-			return Parse(arg, baseScore, temporalScore, environmentalScore);
+			return Parse(arg, baseScore, temporalScore, environmentalScore, false, envProfile);
+		}
+	}
+
+	if (cacheSize && (binary || summary || distinct))
+	{
+		cerr << "--cache cannot be combined with --binary, --summary or --distinct" << endl;
+		return EXIT_FAILURE;
+	}
+
+	if ((nvd || csvDelimiter) && batchOnly)
+	{
+		cerr << "--threads, --binary, --summary, --distinct and --index only apply to --batch" << endl;
+		return EXIT_FAILURE;
+	}
+
+	int ret = EXIT_FAILURE;
+	if (csvDelimiter)
+	{
+		ret = ScoreInput(batchFile, [&](auto &&input) {
+			return ParseCSV(input, cout, cerr, csvColumn - 1, csvDelimiter, csvHeader, baseScore, temporalScore, environmentalScore, false, cacheSize, envProfile);
+		});
+	}
+	else if (nvd)
+	{
+		ret = ScoreInput(batchFile, [&](auto &&input) {
+			return ParseNVD(input, cout, cerr, baseScore, temporalScore, environmentalScore, false, cacheSize, envProfile);
+		});
+	}
+	else if (batch)
+	{
+		ofstream indexStream;
+		if (!indexFile.empty())
+		{
+			indexStream.open(indexFile);
+			if (!indexStream)
+			{
+				cerr << "Unable to open " << indexFile << endl;
+				return EXIT_FAILURE;
+			}
 		}
+		ostream *index = indexFile.empty() ? nullptr : &indexStream;
+		ret = ScoreInput(batchFile, [&](auto &&input) {
+			return ParseBatch(input, cout, cerr, baseScore, temporalScore, environmentalScore, false, threads, cacheSize, envProfile, binary, summary, distinct, index);
+		});
+	}
+	else
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (stats)
+	{
+		if (StatsEnabled())
+			cerr << FormatStats(GetStats());
+		else
+			cerr << "Statistics are not available; rebuild with -DCVSS_INSTRUMENTATION=ON" << endl;
 	}
-	return EXIT_FAILURE;
+	return ret;
 }